@@ -4,6 +4,9 @@
 import PackageDescription
 import CompilerPluginSupport
 
+// Build with `DI_LOCK_DIAGNOSTICS=1` in the environment to record per-lock statistics (see `LockDiagnostics`).
+let lockDiagnostics: [SwiftSetting] = Context.environment["DI_LOCK_DIAGNOSTICS"] == nil ? [] : [.define("DI_LOCK_DIAGNOSTICS")]
+
 let package = Package(
     name: "DependencyInjection",
     platforms: [
@@ -17,6 +20,9 @@ let package = Package(
         .library(
             name: "DependencyInjection",
             targets: ["DependencyInjection"]),
+        .plugin(
+            name: "DependencyGraphPlugin",
+            targets: ["DependencyGraphPlugin"]),
     ],
     dependencies: [
         .package(url: "https://github.com/apple/swift-service-context", from: "1.0.0"),
@@ -42,17 +48,40 @@ let package = Package(
                 "DispatchInterpose",
                 .product(name: "Atomics", package: "swift-atomics"),
                 .product(name: "ServiceContextModule", package: "swift-service-context"),
+            ],
+            swiftSettings: lockDiagnostics
+        ),
+        // Reads factories and their dependencies from source for the build-time graph plugin.
+        .target(
+            name: "DependencyGraph",
+            dependencies: [
+                .product(name: "SwiftSyntax", package: "swift-syntax"),
+                .product(name: "SwiftParser", package: "swift-syntax"),
             ]
         ),
+        .executableTarget(
+            name: "DependencyGraphTool",
+            dependencies: ["DependencyGraph"]
+        ),
+        .plugin(
+            name: "DependencyGraphPlugin",
+            capability: .buildTool(),
+            dependencies: ["DependencyGraphTool"]
+        ),
         .target(
             name: "DispatchInterpose",
             publicHeadersPath: "Include"
         ),
+        .executableTarget(
+            name: "DependencyInjectionBenchmarks",
+            dependencies: ["DependencyInjection"]
+        ),
         .testTarget(
             name: "DependencyInjectionTests",
             dependencies: [
                 "DependencyInjection",
                 "DependencyInjectionMacros",
+                .product(name: "ServiceContextModule", package: "swift-service-context"),
             ]
         ),
         .testTarget(name: "DependencyInjectionMacrosTests",
@@ -61,6 +90,10 @@ let package = Package(
                     .product(name: "MacroTesting", package: "swift-macro-testing"),
                    ]
         ),
+        .testTarget(
+            name: "DependencyGraphTests",
+            dependencies: ["DependencyGraph"]
+        ),
     ],
     swiftLanguageModes: [.version("6")]
 )
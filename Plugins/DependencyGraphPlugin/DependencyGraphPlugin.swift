@@ -0,0 +1,31 @@
+//
+//  DependencyGraphPlugin.swift
+//  DependencyGraphPlugin
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+import PackagePlugin
+
+/// Extracts the target's dependency graph on every build.
+///
+/// The build fails when factories depend on each other while constructing. Otherwise the target
+/// gains `Container.prewarmWaves` for `Container.prewarm(waves:)`, and the full graph is written to
+/// `DependencyGraph.json` in the plugin's work directory.
+@main
+struct DependencyGraphPlugin: BuildToolPlugin {
+    func createBuildCommands(context: PluginContext, target: Target) async throws -> [Command] {
+        guard let target = target as? SourceModuleTarget else { return [] }
+        let inputs = target.sourceFiles(withSuffix: "swift").map(\.url)
+        let source = context.pluginWorkDirectoryURL.appending(path: "DependencyGraph.swift")
+        let manifest = context.pluginWorkDirectoryURL.appending(path: "DependencyGraph.json")
+        return [
+            .buildCommand(displayName: "Extracting the dependency graph of \(target.name)",
+                          executable: try context.tool(named: "DependencyGraphTool").url,
+                          arguments: ["--source-output", source.path(), "--manifest-output", manifest.path()] + inputs.map { $0.path() },
+                          inputFiles: inputs,
+                          outputFiles: [source]),
+        ]
+    }
+}
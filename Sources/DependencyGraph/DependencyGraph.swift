@@ -0,0 +1,200 @@
+//
+//  DependencyGraph.swift
+//  DependencyGraph
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import SwiftParser
+import SwiftSyntax
+
+/// The factories of a module and the dependencies between them, read from source.
+///
+/// A factory depends on another when its resolver refers to it (`Container.database()`), or when
+/// its resolver constructs a type whose `@ConstructorInjected`, `@Injected` or `@LazyInjected`
+/// properties name it. Only ``Kind/construction`` dependencies are resolved while the factory
+/// builds its value, so only they can form a ``cycles`` entry and only they order the ``waves``.
+public struct DependencyGraph: Codable, Equatable, Sendable {
+    public enum Kind: String, Codable, Sendable {
+        /// Resolved while the dependent factory builds its value.
+        case construction
+        /// Resolved later, when an `@Injected` or `@LazyInjected` property is read.
+        case access
+    }
+
+    public struct Dependency: Codable, Hashable, Sendable {
+        /// The ``Factory/id`` of the factory depended on.
+        public let factory: String
+        public let kind: Kind
+    }
+
+    public struct Factory: Codable, Equatable, Sendable {
+        /// The factory as it is referenced in source, such as `Container.database`.
+        public let id: String
+        /// The scope's name, such as `cached`, `shared` or `unique`.
+        public let scope: String
+        /// Whether generated code in the same module can name the factory.
+        public let isAccessible: Bool
+        public let file: String
+        public let line: Int
+        public let dependencies: [Dependency]
+    }
+
+    /// Every factory, sorted by ``Factory/id``.
+    public let factories: [Factory]
+    /// Each set of factories whose construction dependencies form a cycle, as the path from its
+    /// first factory through the ones it depends on; the last depends on the first again.
+    public let cycles: [[String]]
+    /// Factories grouped so that every construction dependency of a factory is in an earlier wave.
+    /// Factories in a cycle, or that depend on one, are in no wave.
+    public let waves: [[String]]
+
+    /// Reads the graph from the Swift sources of one module.
+    public init(sources: [(path: String, text: String)]) {
+        var declared = [DeclaredFactory]()
+        var injectingTypes = [String: InjectingType]()
+        for source in sources {
+            let tree = Parser.parse(source: source.text)
+            let collector = SourceCollector(file: source.path, tree: tree)
+            collector.walk(tree)
+            declared += collector.factories
+            injectingTypes.merge(collector.injectingTypes) { existing, more in
+                var merged = existing
+                merged.injected += more.injected
+                return merged
+            }
+        }
+
+        let ids = Set(declared.map { "\($0.owner).\($0.name)" })
+        func resolve(_ reference: FactoryReference, from owner: String) -> String? {
+            // `Self.name` and bare names resolve against the declaring type. A qualified name is
+            // looked up from the innermost enclosing type outwards, so `Container.x` inside
+            // `Outer.Service` can mean `Outer.Service.Container.x`, `Outer.Container.x` or `Container.x`.
+            let base = reference.base.flatMap { $0 == "Self" ? nil : $0 }
+            let path = owner.split(separator: ".")
+            let enclosing = (0..<path.count).reversed().map { path[...$0].joined(separator: ".") }
+            let candidates = base.map { base in enclosing.map { "\($0).\(base)" } + [base] } ?? [owner]
+            return candidates.lazy.map { "\($0).\(reference.name)" }.first(where: ids.contains)
+        }
+        func injectingTypes(named name: String) -> [InjectingType] {
+            if let type = injectingTypes[name] { return [type] }
+            return injectingTypes.values.filter { $0.name.hasSuffix(".\(name)") }
+        }
+
+        factories = declared.map { factory in
+            var dependencies = Set<Dependency>()
+            for reference in factory.references {
+                if let id = resolve(reference, from: factory.owner) {
+                    dependencies.insert(Dependency(factory: id, kind: .construction))
+                }
+            }
+            for type in factory.constructedTypes.flatMap(injectingTypes(named:)) {
+                for (reference, kind) in type.injected {
+                    if let id = resolve(reference, from: type.name) {
+                        dependencies.insert(Dependency(factory: id, kind: kind))
+                    }
+                }
+            }
+            // A factory read both ways is still needed while constructing.
+            let construction = Set(dependencies.filter { $0.kind == .construction }.map(\.factory))
+            return Factory(id: "\(factory.owner).\(factory.name)",
+                           scope: factory.scope,
+                           isAccessible: factory.isAccessible,
+                           file: factory.file,
+                           line: factory.line,
+                           dependencies: dependencies
+                               .filter { $0.kind == .construction || !construction.contains($0.factory) }
+                               .sorted { ($0.factory, $0.kind.rawValue) < ($1.factory, $1.kind.rawValue) })
+        }
+        .sorted { $0.id < $1.id }
+
+        let edges = Dictionary(factories.map { factory in
+            (factory.id, factory.dependencies.filter { $0.kind == .construction }.map(\.factory))
+        }, uniquingKeysWith: { $0 + $1 })
+        cycles = Self.cycles(in: edges)
+        waves = Self.waves(in: edges)
+    }
+
+    /// The strongly connected components of `edges` with more than one factory or a self-loop,
+    /// found with Tarjan's algorithm.
+    static func cycles(in edges: [String: [String]]) -> [[String]] {
+        var index = [String: Int]()
+        var lowLink = [String: Int]()
+        var stack = [String]()
+        var onStack = Set<String>()
+        var cycles = [[String]]()
+
+        func connect(_ node: String) {
+            index[node] = index.count
+            lowLink[node] = index[node]
+            stack.append(node)
+            onStack.insert(node)
+            for dependency in edges[node, default: []] {
+                if index[dependency] == nil {
+                    connect(dependency)
+                    lowLink[node] = min(lowLink[node]!, lowLink[dependency]!)
+                } else if onStack.contains(dependency) {
+                    lowLink[node] = min(lowLink[node]!, index[dependency]!)
+                }
+            }
+            guard lowLink[node] == index[node] else { return }
+            var component = [String]()
+            while let member = stack.popLast() {
+                onStack.remove(member)
+                component.append(member)
+                if member == node { break }
+            }
+            if component.count > 1 || edges[node, default: []].contains(node) {
+                cycles.append(path(around: Set(component), in: edges))
+            }
+        }
+
+        for node in edges.keys.sorted() where index[node] == nil {
+            connect(node)
+        }
+        return cycles.sorted { $0.lexicographicallyPrecedes($1) }
+    }
+
+    /// The shortest cycle from the first factory of `component` back to itself, so a report reads
+    /// as the chain of resolutions that recurses.
+    private static func path(around component: Set<String>, in edges: [String: [String]]) -> [String] {
+        let start = component.min()!
+        var previous = [String: String]()
+        var queue = [start]
+        var next = 0
+        while next < queue.count {
+            let node = queue[next]
+            next += 1
+            for dependency in edges[node, default: []].sorted() where component.contains(dependency) {
+                if dependency == start {
+                    var path = [node]
+                    while let before = previous[path[0]] {
+                        path.insert(before, at: 0)
+                    }
+                    return path
+                }
+                if previous[dependency] == nil {
+                    previous[dependency] = node
+                    queue.append(dependency)
+                }
+            }
+        }
+        return component.sorted()
+    }
+
+    /// Layers `edges` so each factory sits one wave after its deepest dependency.
+    static func waves(in edges: [String: [String]]) -> [[String]] {
+        var remaining = edges.mapValues { Set($0.filter { edges[$0] != nil }) }
+        var waves = [[String]]()
+        while true {
+            let wave = remaining.filter(\.value.isEmpty).keys.sorted()
+            guard !wave.isEmpty else { break }
+            waves.append(wave)
+            wave.forEach { remaining[$0] = nil }
+            for node in remaining.keys {
+                remaining[node]!.subtract(wave)
+            }
+        }
+        return waves
+    }
+}
@@ -0,0 +1,33 @@
+//
+//  PrewarmSource.swift
+//  DependencyGraph
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+extension DependencyGraph {
+    /// Swift source declaring `Container.prewarmWaves`: the cached factories of the module, grouped
+    /// into the graph's ``waves``, for `Container.prewarm(waves:)`.
+    ///
+    /// Factories that generated code can't name (`private`, `fileprivate`) are left out, as are
+    /// other scopes, which prewarming would skip anyway. Waves left empty are dropped.
+    public var prewarmSource: String {
+        let factories = Dictionary(self.factories.map { ($0.id, $0) }, uniquingKeysWith: { first, _ in first })
+        let waves = self.waves
+            .map { $0.filter { factories[$0].map { $0.scope == "cached" && $0.isAccessible } ?? false } }
+            .filter { !$0.isEmpty }
+        let body = waves.isEmpty ? "[]" : "[\n" + waves.map { "        [\($0.joined(separator: ", "))],\n" }.joined() + "    ]"
+        return """
+        // Generated by DependencyGraphPlugin from this module's factories. Do not edit.
+
+        import DependencyInjection
+
+        extension Container {
+            /// This module's cached factories in construction order: every factory's construction
+            /// dependencies are in an earlier wave.
+            static let prewarmWaves: [[any Prewarmable]] = \(body)
+        }
+
+        """
+    }
+}
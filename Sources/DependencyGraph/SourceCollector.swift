@@ -0,0 +1,325 @@
+//
+//  SourceCollector.swift
+//  DependencyGraph
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import SwiftSyntax
+
+/// A reference to a factory as written in source: `Container.logger`, `Self.logger` or `logger`.
+struct FactoryReference: Hashable {
+    /// The qualifying type as written, or `nil` for a bare name.
+    let base: String?
+    let name: String
+}
+
+/// A `static let x = Factory(...) { ... }` declaration.
+struct DeclaredFactory {
+    let owner: String
+    let name: String
+    let scope: String
+    let isAccessible: Bool
+    let file: String
+    let line: Int
+    /// Factories the resolver refers to directly.
+    let references: Set<FactoryReference>
+    /// Types the resolver constructs, as written (`Service`, `Outer.Service`).
+    let constructedTypes: Set<String>
+}
+
+/// A type with `@Injected`, `@LazyInjected` or `@ConstructorInjected` properties.
+struct InjectingType {
+    let name: String
+    var injected = [(reference: FactoryReference, kind: DependencyGraph.Kind)]()
+}
+
+/// Collects factory declarations and injecting types from one source file.
+final class SourceCollector: SyntaxVisitor {
+    private let file: String
+    private let converter: SourceLocationConverter
+    // Enclosing types, and whether generated code in the module can name them.
+    private var types = [(name: String, isAccessible: Bool)]()
+    // Bodies of functions, accessors and closures: nothing declared there can be named from outside.
+    private var localDepth = 0
+
+    private(set) var factories = [DeclaredFactory]()
+    private(set) var injectingTypes = [String: InjectingType]()
+
+    init(file: String, tree: SourceFileSyntax) {
+        self.file = file
+        converter = SourceLocationConverter(fileName: file, tree: tree)
+        super.init(viewMode: .sourceAccurate)
+    }
+
+    // MARK: Type context
+
+    override func visit(_ node: ExtensionDeclSyntax) -> SyntaxVisitorContinueKind {
+        types.append((node.extendedType.trimmedDescription, isAccessible(node.modifiers)))
+        return .visitChildren
+    }
+
+    override func visitPost(_ node: ExtensionDeclSyntax) {
+        types.removeLast()
+    }
+
+    override func visit(_ node: StructDeclSyntax) -> SyntaxVisitorContinueKind {
+        enterType(node.name.text, modifiers: node.modifiers)
+    }
+
+    override func visitPost(_ node: StructDeclSyntax) {
+        types.removeLast()
+    }
+
+    override func visit(_ node: ClassDeclSyntax) -> SyntaxVisitorContinueKind {
+        enterType(node.name.text, modifiers: node.modifiers)
+    }
+
+    override func visitPost(_ node: ClassDeclSyntax) {
+        types.removeLast()
+    }
+
+    override func visit(_ node: EnumDeclSyntax) -> SyntaxVisitorContinueKind {
+        enterType(node.name.text, modifiers: node.modifiers)
+    }
+
+    override func visitPost(_ node: EnumDeclSyntax) {
+        types.removeLast()
+    }
+
+    override func visit(_ node: ActorDeclSyntax) -> SyntaxVisitorContinueKind {
+        enterType(node.name.text, modifiers: node.modifiers)
+    }
+
+    override func visitPost(_ node: ActorDeclSyntax) {
+        types.removeLast()
+    }
+
+    private func enterType(_ name: String, modifiers: DeclModifierListSyntax) -> SyntaxVisitorContinueKind {
+        let enclosing = types.last
+        types.append((enclosing.map { "\($0.name).\(name)" } ?? name,
+                      (enclosing?.isAccessible ?? true) && isAccessible(modifiers)))
+        return .visitChildren
+    }
+
+    /// A `private` or `fileprivate` declaration, or anything inside one, can't be named from
+    /// the generated file.
+    private func isAccessible(_ modifiers: DeclModifierListSyntax) -> Bool {
+        // `private(set)` restricts only the setter.
+        !modifiers.contains { ["private", "fileprivate"].contains($0.name.text) && $0.detail == nil }
+    }
+
+    // MARK: Local scopes
+
+    override func visit(_ node: FunctionDeclSyntax) -> SyntaxVisitorContinueKind {
+        localDepth += 1
+        return .visitChildren
+    }
+
+    override func visitPost(_ node: FunctionDeclSyntax) {
+        localDepth -= 1
+    }
+
+    override func visit(_ node: InitializerDeclSyntax) -> SyntaxVisitorContinueKind {
+        localDepth += 1
+        return .visitChildren
+    }
+
+    override func visitPost(_ node: InitializerDeclSyntax) {
+        localDepth -= 1
+    }
+
+    override func visit(_ node: AccessorBlockSyntax) -> SyntaxVisitorContinueKind {
+        localDepth += 1
+        return .visitChildren
+    }
+
+    override func visitPost(_ node: AccessorBlockSyntax) {
+        localDepth -= 1
+    }
+
+    override func visit(_ node: ClosureExprSyntax) -> SyntaxVisitorContinueKind {
+        localDepth += 1
+        return .visitChildren
+    }
+
+    override func visitPost(_ node: ClosureExprSyntax) {
+        localDepth -= 1
+    }
+
+    // MARK: Declarations
+
+    override func visit(_ node: VariableDeclSyntax) -> SyntaxVisitorContinueKind {
+        guard localDepth == 0, let owner = types.last else { return .visitChildren }
+        if let factory = factory(declaredBy: node, in: owner.name, ownerIsAccessible: owner.isAccessible) {
+            factories.append(factory)
+            return .skipChildren
+        }
+        for (reference, kind) in injectedDependencies(of: node) {
+            injectingTypes[owner.name, default: InjectingType(name: owner.name)].injected.append((reference, kind))
+        }
+        return .visitChildren
+    }
+
+    private func factory(declaredBy node: VariableDeclSyntax, in owner: String, ownerIsAccessible: Bool) -> DeclaredFactory? {
+        let modifiers = Set(node.modifiers.map(\.name.text))
+        guard modifiers.contains("static") || modifiers.contains("class"),
+              node.bindings.count == 1,
+              let binding = node.bindings.first,
+              let name = binding.pattern.as(IdentifierPatternSyntax.self)?.identifier.text,
+              let call = binding.initializer?.value.as(FunctionCallExprSyntax.self),
+              call.calledExpression.as(DeclReferenceExprSyntax.self)?.baseName.text == "Factory" else {
+            return nil
+        }
+
+        var scope = "unique"
+        var resolver = call.trailingClosure.map(ExprSyntax.init)
+        for argument in call.arguments {
+            switch argument.label?.text {
+            case "scope": scope = scopeName(argument.expression)
+            case "resolver": resolver = argument.expression
+            default: break
+            }
+        }
+
+        let references = ReferenceCollector(viewMode: .sourceAccurate)
+        if let resolver {
+            references.walk(resolver)
+        }
+        return DeclaredFactory(owner: owner,
+                               name: name,
+                               scope: scope,
+                               isAccessible: ownerIsAccessible && isAccessible(node.modifiers),
+                               file: file,
+                               line: node.startLocation(converter: converter).line,
+                               references: references.references,
+                               constructedTypes: references.constructedTypes)
+    }
+
+    /// `.cached`, `.cached(ttl: ...)` and `CachedScope()` all name the `cached` scope.
+    private func scopeName(_ expression: ExprSyntax) -> String {
+        var expression = expression
+        if let call = expression.as(FunctionCallExprSyntax.self) {
+            expression = call.calledExpression
+        }
+        if let member = expression.as(MemberAccessExprSyntax.self) {
+            return member.declName.baseName.text
+        }
+        let text = expression.trimmedDescription
+        return text.hasSuffix("Scope") ? String(text.dropLast("Scope".count)).lowercased() : text
+    }
+
+    private func injectedDependencies(of node: VariableDeclSyntax) -> [(FactoryReference, DependencyGraph.Kind)] {
+        node.attributes.compactMap { element -> (FactoryReference, DependencyGraph.Kind)? in
+            guard let attribute = element.as(AttributeSyntax.self),
+                  let kind = injectionKind(attribute.attributeName.trimmedDescription),
+                  let arguments = attribute.arguments?.as(LabeledExprListSyntax.self),
+                  let factory = arguments.first(where: { $0.label == nil })?.expression,
+                  let reference = FactoryReference(factory) else {
+                return nil
+            }
+            return (reference, kind)
+        }
+    }
+
+    /// Constructor-injected properties resolve in `init`; the others resolve when first read.
+    private func injectionKind(_ attributeName: String) -> DependencyGraph.Kind? {
+        switch attributeName {
+        case "ConstructorInjected": .construction
+        case "Injected", "LazyInjected": .access
+        default: nil
+        }
+    }
+}
+
+/// Collects the factory references and constructed types inside a resolver closure.
+///
+/// A bare name only counts when it is called (`database()`), and not when the resolver binds it
+/// itself (a local, a parameter or a nested function), so `let logger = Logger(); return logger`
+/// is no reference to a `logger` factory.
+final class ReferenceCollector: SyntaxVisitor {
+    private var qualified = Set<FactoryReference>()
+    private var called = Set<String>()
+    // Every name bound anywhere in the closure; scoping is ignored, which only drops candidates.
+    private var bound = Set<String>()
+    private(set) var constructedTypes = Set<String>()
+
+    var references: Set<FactoryReference> {
+        qualified.union(called.subtracting(bound).map { FactoryReference(base: nil, name: $0) })
+    }
+
+    override func visit(_ node: MemberAccessExprSyntax) -> SyntaxVisitorContinueKind {
+        if let reference = FactoryReference(ExprSyntax(node)) {
+            qualified.insert(reference)
+        }
+        // The member name is a `DeclReferenceExprSyntax` too; only the base can hold references.
+        if let base = node.base {
+            walk(base)
+        }
+        return .skipChildren
+    }
+
+    override func visit(_ node: FunctionCallExprSyntax) -> SyntaxVisitorContinueKind {
+        var calledExpression = node.calledExpression
+        if let specialized = calledExpression.as(GenericSpecializationExprSyntax.self) {
+            calledExpression = specialized.expression
+        }
+        if let reference = calledExpression.as(DeclReferenceExprSyntax.self) {
+            let name = reference.baseName.text
+            if name.first?.isUppercase == true {
+                constructedTypes.insert(name)
+            } else {
+                called.insert(name)
+            }
+        } else if let member = calledExpression.as(MemberAccessExprSyntax.self), let base = member.base {
+            let name = member.declName.baseName.text
+            if name == "init" {
+                constructedTypes.insert(base.trimmedDescription)
+            } else if name.first?.isUppercase == true {
+                constructedTypes.insert(member.trimmedDescription)
+            }
+        }
+        return .visitChildren
+    }
+
+    // MARK: Bindings
+
+    override func visit(_ node: IdentifierPatternSyntax) -> SyntaxVisitorContinueKind {
+        bound.insert(node.identifier.text)
+        return .visitChildren
+    }
+
+    override func visit(_ node: ClosureShorthandParameterSyntax) -> SyntaxVisitorContinueKind {
+        bound.insert(node.name.text)
+        return .visitChildren
+    }
+
+    override func visit(_ node: ClosureParameterSyntax) -> SyntaxVisitorContinueKind {
+        bound.insert((node.secondName ?? node.firstName).text)
+        return .visitChildren
+    }
+
+    override func visit(_ node: FunctionDeclSyntax) -> SyntaxVisitorContinueKind {
+        bound.insert(node.name.text)
+        return .visitChildren
+    }
+
+    override func visit(_ node: FunctionParameterSyntax) -> SyntaxVisitorContinueKind {
+        bound.insert((node.secondName ?? node.firstName).text)
+        return .visitChildren
+    }
+}
+
+extension FactoryReference {
+    /// Reads `Base.name` or `name` from an expression such as an `@Injected` argument.
+    init?(_ expression: ExprSyntax) {
+        if let member = expression.as(MemberAccessExprSyntax.self) {
+            guard let base = member.base else { return nil }
+            self.init(base: base.trimmedDescription, name: member.declName.baseName.text)
+        } else if let reference = expression.as(DeclReferenceExprSyntax.self) {
+            self.init(base: nil, name: reference.baseName.text)
+        } else {
+            return nil
+        }
+    }
+}
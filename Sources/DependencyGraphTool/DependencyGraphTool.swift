@@ -0,0 +1,70 @@
+//
+//  DependencyGraphTool.swift
+//  DependencyGraphTool
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import DependencyGraph
+import Foundation
+
+/// Extracts the dependency graph of a module's sources, writes it as a JSON manifest and as the
+/// generated `Container.prewarmWaves`, and fails when construction dependencies form a cycle.
+///
+/// ```
+/// DependencyGraphTool --source-output <path> [--manifest-output <path>] <source.swift>...
+/// ```
+///
+/// `DependencyGraphPlugin` runs this on every build of a target that uses it.
+@main
+struct DependencyGraphTool {
+    struct Options {
+        var sourceOutput: String?
+        var manifestOutput: String?
+        var inputs = [String]()
+
+        init(arguments: some Sequence<String>) {
+            var arguments = arguments.makeIterator()
+            while let argument = arguments.next() {
+                switch argument {
+                case "--source-output": sourceOutput = arguments.next()
+                case "--manifest-output": manifestOutput = arguments.next()
+                default: inputs.append(argument)
+                }
+            }
+        }
+    }
+
+    static func main() throws {
+        let options = Options(arguments: CommandLine.arguments.dropFirst())
+        let sources = try options.inputs.map { (path: $0, text: try String(contentsOfFile: $0, encoding: .utf8)) }
+        let graph = DependencyGraph(sources: sources)
+
+        if let manifestOutput = options.manifestOutput {
+            let encoder = JSONEncoder()
+            encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+            try write(encoder.encode(graph), to: manifestOutput)
+        }
+        if let sourceOutput = options.sourceOutput {
+            try write(Data(graph.prewarmSource.utf8), to: sourceOutput)
+        }
+
+        guard graph.cycles.isEmpty else {
+            let factories = Dictionary(graph.factories.map { ($0.id, $0) }, uniquingKeysWith: { first, _ in first })
+            for cycle in graph.cycles {
+                // Reported at the first factory, in the `file:line: error:` form build logs link to.
+                let location = cycle.first.flatMap { factories[$0] }.map { "\($0.file):\($0.line): " } ?? ""
+                let path = (cycle + cycle.prefix(1)).joined(separator: " -> ")
+                FileHandle.standardError.write(Data("\(location)error: factories depend on each other while constructing: \(path)\n".utf8))
+            }
+            exit(1)
+        }
+    }
+
+    /// Writes only when the contents change, so an unchanged graph doesn't recompile the module.
+    private static func write(_ data: Data, to path: String) throws {
+        let url = URL(fileURLWithPath: path)
+        guard (try? Data(contentsOf: url)) != data else { return }
+        try data.write(to: url, options: .atomic)
+    }
+}
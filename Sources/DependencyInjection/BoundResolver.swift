@@ -0,0 +1,222 @@
+//
+//  BoundResolver.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+/// Resolves factories against a captured container, wherever the handle is used.
+///
+/// Code that resolves many dependencies in a row, or later from another context, can capture
+/// the container once and resolve through the handle:
+///
+/// ```swift
+/// init() {
+///     let resolve = BoundResolver()
+///     logger = resolve(Container.logger)
+///     session = resolve(Container.session)
+///     analytics = resolve(Container.analytics)
+/// }
+/// ```
+///
+/// Resolving through the handle behaves like calling the factory inside
+/// `withContainer(resolve.container) { ... }`, including for the dependencies its resolver
+/// resolves in turn. When the bound container is already current the factory resolves in place;
+/// otherwise the call applies the bound container's context first. To apply it once for a run of
+/// resolutions, use `withBinding(_:)`.
+public struct BoundResolver: Sendable {
+    /// The container every resolution goes through.
+    public let container: Container
+    // Set on handles that only run with `container` already current, so they skip the check.
+    private let isCurrent: Bool
+
+    /// Creates a handle bound to `container`, which defaults to the current container.
+    public init(_ container: Container = .current) {
+        self.init(container, isCurrent: false)
+    }
+
+    init(_ container: Container, isCurrent: Bool) {
+        self.container = container
+        self.isCurrent = isCurrent
+    }
+
+    /// Runs `operation` with a handle bound to the current container, reading the context once.
+    ///
+    /// The handle resolves in place for the whole of `operation`, which is how
+    /// ``ConstructorInjection()`` types resolve their batched properties in a single lookup. Tasks
+    /// created in `operation` inherit its context and may use the handle; nothing else should
+    /// keep it past `operation`.
+    public static func withCurrent<T>(_ operation: (BoundResolver) throws -> T) rethrows -> T {
+        try operation(BoundResolver(.current, isCurrent: true))
+    }
+
+    /// Runs `operation` with the bound container as ``Container/current``, passing it a handle
+    /// that resolves in place without checking the context again.
+    ///
+    /// ```swift
+    /// let (logger, session) = BoundResolver(container).withBinding { resolve in
+    ///     (resolve(Container.logger), resolve(Container.session))
+    /// }
+    /// ```
+    ///
+    /// Don't let the handle escape `operation`; outside it the container may no longer be current.
+    public func withBinding<T>(_ operation: (BoundResolver) throws -> T) rethrows -> T {
+        guard !isCurrent else { return try operation(self) }
+        return try withContainer(container) { try operation(BoundResolver(container, isCurrent: true)) }
+    }
+
+    /// Runs the asynchronous `operation` with the bound container as ``Container/current``,
+    /// passing it a handle that resolves in place without checking the context again.
+    ///
+    /// Don't let the handle escape `operation`; outside it the container may no longer be current.
+    public func withBinding<T>(isolation: isolated(any Actor)? = #isolation,
+                               _ operation: (BoundResolver) async throws -> T) async rethrows -> T {
+        guard !isCurrent else { return try await operation(self) }
+        return try await withContainer(container) { try await operation(BoundResolver(container, isCurrent: true)) }
+    }
+
+    /// Resolves `factory` in the bound container.
+    public func callAsFunction<D>(_ factory: SyncFactory<D>, file: String = #file, line: UInt = #line, function: String = #function) -> D {
+        guard isBound else {
+            return withContainer(container) { container.resolve(factory: factory, file: file, line: line, function: function) }
+        }
+        return container.resolve(factory: factory, file: file, line: line, function: function)
+    }
+
+    /// Resolves `factory` in the bound container, or throws if the resolver fails.
+    public func callAsFunction<D>(_ factory: SyncThrowingFactory<D>, file: String = #file, line: UInt = #line, function: String = #function) throws -> D {
+        guard isBound else {
+            return try withContainer(container) { try container.resolve(factory: factory, file: file, line: line, function: function) }
+        }
+        return try container.resolve(factory: factory, file: file, line: line, function: function)
+    }
+
+    /// Resolves `factory` in the bound container.
+    public func callAsFunction<D>(_ factory: AsyncFactory<D>, file: String = #file, line: UInt = #line, function: String = #function) async -> D {
+        guard isBound else {
+            return await withContainer(container) { await container.resolve(factory: factory, file: file, line: line, function: function) }
+        }
+        return await container.resolve(factory: factory, file: file, line: line, function: function)
+    }
+
+    /// Resolves `factory` in the bound container, or throws if the resolver fails.
+    public func callAsFunction<D>(_ factory: AsyncThrowingFactory<D>, file: String = #file, line: UInt = #line, function: String = #function) async throws -> D {
+        guard isBound else {
+            return try await withContainer(container) { try await container.resolve(factory: factory, file: file, line: line, function: function) }
+        }
+        return try await container.resolve(factory: factory, file: file, line: line, function: function)
+    }
+
+    // Resolving in place is only equivalent when the bound container is current: caching scopes
+    // key by `Container.current`, and so do the nested resolutions of every resolver.
+    private var isBound: Bool {
+        isCurrent || Container.current === container
+    }
+}
+
+// MARK: Batch resolution
+
+extension BoundResolver {
+    /// Resolves every factory in the bound container and returns the results in order.
+    ///
+    /// ```swift
+    /// let (logger, session) = resolve.resolve(Container.logger, Container.session)
+    /// ```
+    public func resolve<each D>(_ factories: repeat SyncFactory<each D>) -> (repeat each D) {
+        withBinding { resolve in (repeat resolve(each factories)) }
+    }
+
+    /// Resolves every factory in the bound container and returns the results in order,
+    /// stopping at the first resolver that throws.
+    public func resolve<each D>(_ factories: repeat SyncThrowingFactory<each D>) throws -> (repeat each D) {
+        try withBinding { resolve in try (repeat resolve(each factories)) }
+    }
+
+    /// Resolves every factory in the bound container concurrently and returns the results in order.
+    ///
+    /// Each resolver runs in its own child task, so independent slow resolvers overlap instead of
+    /// running one after another. Cached and shared factories keep their usual deduplication.
+    public func resolve<each D: Sendable>(_ factories: repeat AsyncFactory<each D>) async -> (repeat each D) {
+        // Child tasks inherit the binding's context, so every resolver runs in place.
+        let results = await withBinding { resolve in
+            await withTaskGroup(of: (Int, any Sendable).self, returning: PackedResults.self) { group in
+                var count = 0
+                for factory in repeat each factories {
+                    let index = count
+                    group.addTask { (index, await resolve(factory)) }
+                    count += 1
+                }
+                var values = [(any Sendable)?](repeating: nil, count: count)
+                for await (index, value) in group {
+                    values[index] = value
+                }
+                return PackedResults(values)
+            }
+        }
+        return (repeat results.next(as: (each D).self))
+    }
+
+    /// Resolves every factory in the bound container concurrently and returns the results in order.
+    ///
+    /// If any resolver throws, the remaining child tasks are cancelled and the error is rethrown.
+    public func resolve<each D: Sendable>(_ factories: repeat AsyncThrowingFactory<each D>) async throws -> (repeat each D) {
+        let results = try await withBinding { resolve in
+            try await withThrowingTaskGroup(of: (Int, any Sendable).self, returning: PackedResults.self) { group in
+                var count = 0
+                for factory in repeat each factories {
+                    let index = count
+                    group.addTask { (index, try await resolve(factory)) }
+                    count += 1
+                }
+                var values = [(any Sendable)?](repeating: nil, count: count)
+                for try await (index, value) in group {
+                    values[index] = value
+                }
+                return PackedResults(values)
+            }
+        }
+        return (repeat results.next(as: (each D).self))
+    }
+}
+
+extension Container {
+    /// Resolves every factory with a single lookup of ``current``.
+    ///
+    /// ```swift
+    /// let (logger, session, analytics) = Container.resolve(Container.logger, Container.session, Container.analytics)
+    /// ```
+    public static func resolve<each D>(_ factories: repeat SyncFactory<each D>) -> (repeat each D) {
+        BoundResolver(.current, isCurrent: true).resolve(repeat each factories)
+    }
+
+    /// Resolves every factory with a single lookup of ``current``, stopping at the first resolver that throws.
+    public static func resolve<each D>(_ factories: repeat SyncThrowingFactory<each D>) throws -> (repeat each D) {
+        try BoundResolver(.current, isCurrent: true).resolve(repeat each factories)
+    }
+
+    /// Resolves every factory concurrently with a single lookup of ``current``.
+    public static func resolve<each D: Sendable>(_ factories: repeat AsyncFactory<each D>) async -> (repeat each D) {
+        await BoundResolver(.current, isCurrent: true).resolve(repeat each factories)
+    }
+
+    /// Resolves every factory concurrently with a single lookup of ``current``.
+    public static func resolve<each D: Sendable>(_ factories: repeat AsyncThrowingFactory<each D>) async throws -> (repeat each D) {
+        try await BoundResolver(.current, isCurrent: true).resolve(repeat each factories)
+    }
+}
+
+/// Results of a concurrent batch resolution, read back in factory order.
+private final class PackedResults {
+    private let values: [(any Sendable)?]
+    private var index = 0
+
+    init(_ values: [(any Sendable)?]) {
+        self.values = values
+    }
+
+    func next<T>(as type: T.Type) -> T {
+        defer { index += 1 }
+        // Every child task stores its value before the group finishes, so the slot is populated.
+        return values[index]! as! T
+    }
+}
@@ -5,6 +5,7 @@
 //  Created by Tyler Thompson on 8/1/24.
 //
 import Foundation
+import Atomics
 
 /// A protocol representing a dependency cache that can be cleared.
 ///
@@ -20,55 +21,106 @@ public protocol Cache: Sendable {
     func clear()
 }
 
-extension Cache {
-    var hasValue: Bool {
-        (self as? _Cache)?.hasValue ?? false
-    }
-
-    func callAsFunction() -> Any? {
-        (self as? _Cache)?.callAsFunction()
-    }
-
-    func register(_ dependency: Any) {
-        (self as? _Cache)?.register(dependency)
-    }
+/// A cache whose entries are bound to the lifetime of the container they were stored for.
+///
+/// Storing a value binds the cache to the current container with ``Container/bind(_:)``;
+/// when that container is deallocated it calls ``evict(containerID:)`` so the entry is
+/// dropped instead of lingering (and possibly being served to a recycled `ObjectIdentifier`).
+protocol ContainerBoundCache: AnyObject {
+    func evict(containerID: ObjectIdentifier)
 }
 
-protocol _Cache {
-    var hasValue: Bool { get }
+/// Limits on how long, and how many, values a ``StrongCache`` keeps.
+struct EvictionPolicy: Sendable {
+    /// How long a value stays cached after it is stored.
+    var ttl: Duration?
+    /// The most containers the cache holds a value for at once.
+    var capacity: Int?
 
-    func callAsFunction() -> Any?
+    static let none = EvictionPolicy()
 
-    func register(_ dependency: Any)
+    var evicts: Bool { ttl != nil || capacity != nil }
 }
 
 @available(iOS 13.0, macOS 10.15, tvOS 14.0, watchOS 7.0, *)
-final class StrongCache: Cache, _Cache, @unchecked Sendable {
-    private final class Entry {
-        var registeredValue: Any?
-        var hasValue: Bool = false
+final class StrongCache: Cache, ContainerBoundCache, @unchecked Sendable {
+    /// Bookkeeping for an eviction policy; both fields are `nil` for a cache that never evicts.
+    private class Entry {
+        let expiresAt: ContinuousClock.Instant?
+        // Second-chance bit for capacity eviction: set on every hit, cleared as the sweep passes.
+        let referenced: ManagedAtomic<Bool>?
+
+        init(expiresAt: ContinuousClock.Instant?, referenced: ManagedAtomic<Bool>?) {
+            self.expiresAt = expiresAt
+            self.referenced = referenced
+        }
+
+        /// Whether the entry may still be served, recording the access for capacity eviction.
+        func isLive(at now: @autoclosure () -> ContinuousClock.Instant) -> Bool {
+            if let expiresAt, now() >= expiresAt { return false }
+            if let referenced, !referenced.load(ordering: .relaxed) {
+                referenced.store(true, ordering: .relaxed)
+            }
+            return true
+        }
     }
 
-    private var lock = NSRecursiveLock()
-    private var storage = [ObjectIdentifier: Entry]()
+    /// A cached value together with its static type. A lookup for `D` checks the box's
+    /// metatype and downcasts without a dynamic cast, and values are never boxed as `Any`.
+    private final class Box<D>: Entry {
+        let value: D
 
-    private func entry(for container: Container) -> Entry {
-        let id = ObjectIdentifier(container)
-        if let e = storage[id] { return e }
-        let e = Entry()
-        storage[id] = e
-        return e
+        init(_ value: D, expiresAt: ContinuousClock.Instant?, referenced: ManagedAtomic<Bool>?) {
+            self.value = value
+            super.init(expiresAt: expiresAt, referenced: referenced)
+        }
+    }
+
+    /// An immutable map of container to cached value. Writers copy it under `lock` and publish
+    /// the copy, so hits can be served with a single atomic load.
+    private final class Snapshot: AtomicReference, @unchecked Sendable {
+        let values: [ObjectIdentifier: Entry]
+        // Containers in the order capacity eviction visits them; empty without a capacity.
+        let order: [ObjectIdentifier]
+
+        init(values: [ObjectIdentifier: Entry] = [:], order: [ObjectIdentifier] = []) {
+            self.values = values
+            self.order = order
+        }
+    }
+
+    private let lock = TrackedLock(site: "StrongCache")
+    private let snapshot = ManagedAtomic(Snapshot())
+    /// Advanced whenever an entry is removed or replaced, so a copy of a cached value (a frozen
+    /// container's inlined value) can tell it is stale. Only written under `lock`.
+    let version = ManagedAtomic(0)
+    let policy: EvictionPolicy
+
+    init(policy: EvictionPolicy = .none) {
+        precondition((policy.capacity ?? 1) > 0, "A cache capacity must be at least 1")
+        self.policy = policy
     }
 
     private func currentContainer() -> Container { Container.current }
 
-    private func searchEntryForRead() -> Entry? {
+    /// The value cached for exactly the current container, or `nil` on a miss. Never locks.
+    func cachedValueForCurrentContainer<D>(as type: D.Type) -> D? {
+        guard let entry = snapshot.load(ordering: .acquiring).values[ObjectIdentifier(currentContainer())],
+              entry.isLive(at: .now) else {
+            return nil
+        }
+        return unbox(entry, as: type)
+    }
+
+    /// The closest cached value in the current container hierarchy, or `nil` on a miss.
+    func cachedValue<D>(as type: D.Type) -> D? {
+        let values = snapshot.load(ordering: .acquiring).values
         var container: Container? = currentContainer()
         // Allow parent fallback except when running under a TestContainer
         let allowParents = !(container is TestContainer)
         while let c = container {
-            let id = ObjectIdentifier(c)
-            if let e = storage[id], e.hasValue { return e }
+            // Expired entries are misses, so the scope resolves and replaces them.
+            if let entry = values[ObjectIdentifier(c)], entry.isLive(at: .now) { return unbox(entry, as: type) }
             if allowParents {
                 container = c.parent
             } else {
@@ -78,53 +130,107 @@ final class StrongCache: Cache, _Cache, @unchecked Sendable {
         return nil
     }
 
-    var hasValue: Bool {
-        defer { lock.unlock() }
-        lock.lock()
-        return searchEntryForRead() != nil
+    func register<D>(_ dependency: D) {
+        let container = currentContainer()
+        container.bind(self)
+        let id = ObjectIdentifier(container)
+        let box = Box(dependency,
+                      expiresAt: policy.ttl.map { ContinuousClock.now + $0 },
+                      referenced: policy.capacity.map { _ in ManagedAtomic(false) })
+        // The new entry is spared: its bit is still clear, so a sweep over hot entries would evict it first.
+        update(sparing: id) { values, order in
+            values[id] = box
+            if policy.capacity != nil {
+                order.removeAll { $0 == id }
+                order.append(id)
+            }
+        }
     }
 
-    func callAsFunction() -> Any? {
-        defer { lock.unlock() }
-        lock.lock()
-        let e = searchEntryForRead() ?? entry(for: currentContainer())
-        return e.registeredValue
+    public func clear() {
+        let id = ObjectIdentifier(currentContainer())
+        update { values, order in
+            values[id] = nil
+            order.removeAll { $0 == id }
+        }
+        _resolutionGeneration.wrappingIncrement(ordering: .releasing)
     }
 
-    func register(_ dependency: Any) {
-        defer { lock.unlock() }
-        lock.lock()
-        let e = entry(for: currentContainer())
-        e.registeredValue = dependency
-        e.hasValue = true
+    func evict(containerID: ObjectIdentifier) {
+        update { values, order in
+            values[containerID] = nil
+            order.removeAll { $0 == containerID }
+        }
     }
 
-    public func clear() {
-        defer { lock.unlock() }
-        lock.lock()
-        let e = entry(for: currentContainer())
-        e.registeredValue = nil
-        e.hasValue = false
+    // A scope shared by factories of different types can hold a box of another type; that is a miss.
+    private func unbox<D>(_ entry: Entry, as type: D.Type) -> D? {
+        guard Swift.type(of: entry) == Box<D>.self else { return nil }
+        return unsafeDowncast(entry, to: Box<D>.self).value
+    }
+
+    /// Applies `body` to a copy of the current values, enforces the eviction policy on the copy
+    /// and publishes it. Readers keep serving the previous snapshot until the store, so evicting
+    /// never blocks a concurrent hit.
+    private func update(sparing spared: ObjectIdentifier? = nil, _ body: (inout [ObjectIdentifier: Entry], inout [ObjectIdentifier]) -> Void) {
+        lock.protect {
+            let current = snapshot.load(ordering: .relaxed)
+            var values = current.values
+            var order = current.order
+            body(&values, &order)
+            if policy.ttl != nil {
+                let now = ContinuousClock.now
+                values = values.filter { _, entry in entry.expiresAt.map { now < $0 } ?? true }
+                order.removeAll { values[$0] == nil }
+            }
+            if let capacity = policy.capacity {
+                Self.evictLeastRecentlyUsed(from: &values, order: &order, toFit: capacity, sparing: spared)
+            }
+            if current.values.contains(where: { values[$0.key] !== $0.value }) {
+                version.wrappingIncrement(ordering: .releasing)
+            }
+            snapshot.store(Snapshot(values: values, order: order), ordering: .releasing)
+        }
+    }
+
+    /// A CLOCK sweep: entries hit since the hand last passed get a second chance, the rest are evicted.
+    /// `spared` is never evicted; a capacity of at least 1 leaves the sweep another entry to take.
+    private static func evictLeastRecentlyUsed(from values: inout [ObjectIdentifier: Entry], order: inout [ObjectIdentifier], toFit capacity: Int, sparing spared: ObjectIdentifier?) {
+        // Two passes clear every bit, so this terminates even while hits keep setting them.
+        var remainingVisits = 2 * order.count
+        while values.count > capacity, !order.isEmpty {
+            let id = order.removeFirst()
+            guard let entry = values[id] else { continue }
+            if id == spared {
+                order.append(id)
+                continue
+            }
+            remainingVisits -= 1
+            if remainingVisits > 0, entry.referenced?.exchange(false, ordering: .relaxed) == true {
+                order.append(id)
+            } else {
+                values[id] = nil
+            }
+        }
     }
 }
 
 @available(iOS 13.0, macOS 10.15, tvOS 14.0, watchOS 7.0, *)
-final class WeakCache: Cache, _Cache, @unchecked Sendable {
+final class WeakCache: Cache, ContainerBoundCache, @unchecked Sendable {
     private final class Entry {
+        // The static type the value was registered as; lookups for any other type miss.
+        let type: ObjectIdentifier
         weak var value: AnyObject?
+
+        init(type: ObjectIdentifier, value: AnyObject) {
+            self.type = type
+            self.value = value
+        }
     }
 
-    private var lock = NSRecursiveLock()
+    private let lock = TrackedLock(site: "WeakCache")
     private var storage = [ObjectIdentifier: Entry]()
 
-    private func entry(for container: Container) -> Entry {
-        let id = ObjectIdentifier(container)
-        if let e = storage[id] { return e }
-        let e = Entry()
-        storage[id] = e
-        return e
-    }
-
     private func currentContainer() -> Container { Container.current }
 
     private func searchEntryForRead() -> Entry? {
@@ -142,30 +248,41 @@ final class WeakCache: Cache, _Cache, @unchecked Sendable {
         return nil
     }
 
-    var hasValue: Bool {
+    /// The closest live value in the current container hierarchy, or `nil` on a miss.
+    func cachedValue<D>(as type: D.Type) -> D? {
         defer { lock.unlock() }
         lock.lock()
-        return searchEntryForRead()?.value != nil
+        guard let entry = searchEntryForRead(),
+              entry.type == ObjectIdentifier(type),
+              let value = entry.value else {
+            return nil
+        }
+        // The entry was registered as `D`, so for class types the object is a `D` already.
+        // Existentials still need the cast to recover their witness tables.
+        if type is AnyClass {
+            return unsafeBitCast(value, to: type)
+        }
+        return value as? D
     }
 
-    func callAsFunction() -> Any? {
+    func register<D>(_ dependency: D) {
+        let container = currentContainer()
+        container.bind(self)
         defer { lock.unlock() }
         lock.lock()
-        let e = searchEntryForRead() ?? entry(for: currentContainer())
-        return e.value
+        storage[ObjectIdentifier(container)] = Entry(type: ObjectIdentifier(D.self), value: dependency as AnyObject)
     }
 
-    func register(_ dependency: Any) {
+    public func clear() {
         defer { lock.unlock() }
         lock.lock()
-        let e = entry(for: currentContainer())
-        e.value = dependency as AnyObject
+        storage[ObjectIdentifier(currentContainer())] = nil
+        _resolutionGeneration.wrappingIncrement(ordering: .releasing)
     }
 
-    public func clear() {
+    func evict(containerID: ObjectIdentifier) {
         defer { lock.unlock() }
         lock.lock()
-        let e = entry(for: currentContainer())
-        e.value = nil
+        storage[containerID] = nil
     }
 }
@@ -7,6 +7,11 @@
 import Foundation
 import Atomics
 
+// Bumped after every registration change in any container and every cache clear. Memoized
+// `@Injected(memoized: true)` values are stamped with it, so a change anywhere (including an
+// ancestor) invalidates them.
+let _resolutionGeneration = ManagedAtomic<Int>(0)
+
 /// The dependency resolution context.
 ///
 /// `Container` holds the registration stacks for all factories and resolves dependencies
@@ -38,141 +43,514 @@ import Atomics
 /// Containers form a hierarchy via ``withNestedContainer(operation:)-7glsq``. Child containers
 /// inherit registrations from their parent but can override them independently.
 public class Container: @unchecked Sendable {
-    private let lock = NSRecursiveLock()
-    private var storage = [AnyHashable: StorageBase]()
+    private let lock = TrackedLock(site: "Container")
+    // Readers load the current snapshot without locking; writers serialize on `lock`,
+    // build a new snapshot and publish it with release ordering.
+    private let registry: ManagedAtomic<Registry>
+    // Caches holding entries for this container; they are told to evict them on deinit.
+    private var boundCaches = [ObjectIdentifier: BoundCacheReference]()
+    // Memoized answer to "which ancestor resolves this factory", keyed by factory slot.
+    private let lineage = ManagedAtomic<Lineage?>(nil)
+    // Counts registration changes in the containers a walk from this one can reach: this one and
+    // its ancestors up to the nearest test container or root, which start a hierarchy of their own.
+    // Only reassigned while the pool holds the sole reference.
+    var hierarchy: HierarchyVersion
+    // A diagnostic switch that guards no other state, so every resolve can read it with a relaxed load.
     private var _fatalErrorOnResolve = ManagedAtomic(false)
     var fatalErrorOnResolve: Bool {
-        get { _fatalErrorOnResolve.load(ordering: .sequentiallyConsistent) }
-        set { _fatalErrorOnResolve.store(newValue, ordering: .sequentiallyConsistent) }
+        get { _fatalErrorOnResolve.load(ordering: .relaxed) }
+        set {
+            _fatalErrorOnResolve.store(newValue, ordering: .releasing)
+            // Frozen resolution skips this check, so turning it on thaws the container.
+            if newValue { thaw() }
+        }
+    }
+
+    /// Whether a memoized value may stand in for a resolution in this container.
+    ///
+    /// Resolutions that would fail a leak or context check must actually run, so memos are
+    /// bypassed while this container or an ancestor is set to fatal error on resolve.
+    var memoizesResolutions: Bool {
+        !fatalErrorOnResolve && (parent?.memoizesResolutions ?? true)
+    }
+
+    var parent: Container? {
+        didSet {
+            // A pooled container joins its new parent's hierarchy.
+            if let parent, !(self is TestContainer) {
+                hierarchy = parent.hierarchy
+            }
+        }
     }
+    // Advanced each time the pool recycles this instance, so anything that remembered the
+    // container by identity alone can tell the new use from the old one. Only written while
+    // the pool holds the sole strong reference.
+    private(set) var incarnation = 0
 
-    var parent: Container?
-    init(parent: Container? = nil) {
+    /// Creates a container whose registrations start out as `registry`.
+    ///
+    /// The snapshot is adopted as is: its storage is copied only when this container changes it.
+    init(parent: Container? = nil, registry: Registry = .empty) {
         self.parent = parent
+        self.registry = ManagedAtomic(registry)
+        hierarchy = parent?.hierarchy ?? HierarchyVersion()
+    }
+
+    deinit {
+        let id = ObjectIdentifier(self)
+        for reference in boundCaches.values {
+            reference.cache?.evict(containerID: id)
+        }
+    }
+
+    /// Returns this container to its freshly initialized state so ``ContainerPool`` can hand it out again.
+    ///
+    /// Cache entries are evicted as on deinit, and registrations and memoized lookups are dropped.
+    func recycle() {
+        let id = ObjectIdentifier(self)
+        let caches = lock.protect {
+            defer { boundCaches = [:] }
+            return boundCaches
+        }
+        for reference in caches.values {
+            reference.cache?.evict(containerID: id)
+        }
+        registry.store(.empty, ordering: .releasing)
+        lineage.store(nil, ordering: .releasing)
+        fatalErrorOnResolve = false
+        parent = nil
+        incarnation &+= 1
+    }
+
+    /// Ties the entries `cache` stores for this container to the container's lifetime.
+    func bind(_ cache: some ContainerBoundCache) {
+        let id = ObjectIdentifier(cache)
+        lock.protect {
+            guard boundCaches[id]?.cache !== cache else { return }
+            boundCaches[id] = BoundCacheReference(cache)
+        }
+    }
+
+    /// The container's current registrations, which stay valid after later changes to the container.
+    var registrySnapshot: Registry {
+        registry.load(ordering: .acquiring)
     }
 
     func storage<F: _Factory>(for factory: F) -> Storage<F>? {
-        lock.protect { (self.storage[factory] as? Storage<F>) }
+        registry.load(ordering: .acquiring).storage(for: factory)
+    }
+
+    /// Whether ``freeze()`` is in effect.
+    public var isFrozen: Bool {
+        registry.load(ordering: .acquiring).frozen != nil
+    }
+
+    /// Switches this container to a precomputed, read-only resolution table.
+    ///
+    /// Call it once registrations are final, typically at the end of launch:
+    ///
+    /// ```swift
+    /// Container.default.freeze()
+    /// ```
+    ///
+    /// While frozen, resolving through this container reads the table and skips the registration
+    /// and resolution checks. Values of ``CachedScope`` factories (without TTL or capacity limits)
+    /// are inlined into the table once built, so later resolutions return them without consulting
+    /// the scope. Nothing on that path takes a lock.
+    ///
+    /// The container thaws itself on the slow path if its registrations change, for example through
+    /// `register` or `popRegistration`, or if resolution checks are turned on by
+    /// ``withTestContainer(defaults:unregisteredBehavior:leakedResolutionBehavior:file:line:function:operation:)-1hkwu``.
+    /// While one of those is running, the container stays thawed and `freeze()` does nothing.
+    ///
+    /// Only a root container (such as ``default``) can be frozen; nested and test containers are
+    /// short-lived and already resolve through their parents.
+    public func freeze() {
+        precondition(!(self is TestContainer), "A test container cannot be frozen.")
+        precondition(parent == nil, "Only a root container such as Container.default can be frozen; this container has a parent.")
+        lock.protect {
+            guard !fatalErrorOnResolve else { return }
+            let current = registry.load(ordering: .relaxed)
+            guard current.frozen == nil else { return }
+            registry.store(current.freezing(), ordering: .releasing)
+        }
+    }
+
+    /// Returns a frozen container to ordinary, mutable resolution. Does nothing if it isn't frozen.
+    public func thaw() {
+        lock.protect {
+            let current = registry.load(ordering: .relaxed)
+            guard current.frozen != nil else { return }
+            registry.store(current.thawed(), ordering: .releasing)
+        }
     }
 
     func resolve<D>(factory: SyncFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) -> D {
-        if fatalErrorOnResolve && !hasTaskLocalContext {
+        let registry = self.registry.load(ordering: .acquiring)
+        if let slot = registry.frozen?[factory.slot] {
+            // Direct calls run with this container as the current one, so its cache entry is what the scope would return.
+            if !hasTaskLocalContext, let value = slot.inlinedValue(as: D.self) {
+                return value
+            }
+            let resolver = slot.resolver(for: factory) ?? factory.resolver
+            guard !hasTaskLocalContext, let cache = slot.inliningCache(for: factory) else {
+                return scopeResolve(factory, resolver: resolver)
+            }
+            let version = cache.version.load(ordering: .acquiring)
+            let value = scopeResolve(factory, resolver: resolver)
+            slot.inline(value, from: cache, version: version)
+            return value
+        }
+        if !hasTaskLocalContext && fatalErrorOnResolve {
             fatalError("Tried to resolve dependency: \(String(describing: D.self)) when container was set to fatal error on resolution. This is likely because tests executed a task that did not have the container context. This often happens on a detached task. Please use `Container.current` and `withContainer` to add container information back to a detached task. Called from \(file):\(line) in \(function). It's also possible you just didn't use `withTestContainer` around a test that needed it and now have test interference from tests that do use that.")
         }
-        if let currentResolver = storage(for: factory)?.syncRegistrations.currentResolver() {
-            return factory.scope.resolve(resolver: currentResolver)
+        if let currentResolver = registry.storage(for: factory)?.registrations.currentResolver {
+            return scopeResolve(factory, resolver: currentResolver)
         }
-        // If no resolver found and parent is a TestContainer, delegate to parent's resolve method
+        // If no resolver found, delegate to the closest ancestor that can resolve it
         if let parent = parent {
-            return parent.resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
+            return resolvingAncestor(for: factory, from: parent).resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
         }
         // Otherwise use the factory's default resolver
-        return factory.scope.resolve(resolver: factory.resolver)
+        return scopeResolve(factory, resolver: factory.resolver)
     }
 
     func resolve<D>(factory: SyncThrowingFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) throws -> D {
-        if fatalErrorOnResolve && !hasTaskLocalContext {
+        let registry = self.registry.load(ordering: .acquiring)
+        if let slot = registry.frozen?[factory.slot] {
+            // Direct calls run with this container as the current one, so its cache entry is what the scope would return.
+            if !hasTaskLocalContext, let value = slot.inlinedValue(as: D.self) {
+                return value
+            }
+            let resolver = slot.resolver(for: factory) ?? factory.resolver
+            guard !hasTaskLocalContext, let cache = slot.inliningCache(for: factory) else {
+                return try scopeResolve(factory, resolver: resolver)
+            }
+            let version = cache.version.load(ordering: .acquiring)
+            let value = try scopeResolve(factory, resolver: resolver)
+            slot.inline(value, from: cache, version: version)
+            return value
+        }
+        if !hasTaskLocalContext && fatalErrorOnResolve {
             fatalError("Tried to resolve dependency: \(String(describing: D.self)) when container was set to fatal error on resolution. This is likely because tests executed a task that did not have the container context. This often happens on a detached task. Please use `Container.current` and `withContainer` to add container information back to a detached task. Called from \(file):\(line) in \(function). It's also possible you just didn't use `withTestContainer` around a test that needed it and now have test interference from tests that do use that.")
         }
-        if let currentResolver = storage(for: factory)?.syncThrowingRegistrations.currentResolver() {
-            return try factory.scope.resolve(resolver: currentResolver)
+        if let currentResolver = registry.storage(for: factory)?.registrations.currentResolver {
+            return try scopeResolve(factory, resolver: currentResolver)
         }
-        // If no resolver found and parent is a TestContainer, delegate to parent's resolve method
+        // If no resolver found, delegate to the closest ancestor that can resolve it
         if let parent = parent {
-            return try parent.resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
+            return try resolvingAncestor(for: factory, from: parent).resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
         }
         // Otherwise use the factory's default resolver
-        return try factory.scope.resolve(resolver: factory.resolver)
+        return try scopeResolve(factory, resolver: factory.resolver)
     }
 
     func resolve<D>(factory: AsyncFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) async -> D {
-        if fatalErrorOnResolve && !hasTaskLocalContext {
+        let registry = self.registry.load(ordering: .acquiring)
+        if let slot = registry.frozen?[factory.slot] {
+            // Direct calls run with this container as the current one, so its cache entry is what the scope would return.
+            if !hasTaskLocalContext, let value = slot.inlinedValue(as: D.self) {
+                return value
+            }
+            let resolver = slot.resolver(for: factory) ?? factory.resolver
+            guard !hasTaskLocalContext, let cache = slot.inliningCache(for: factory) else {
+                return await scopeResolve(factory, resolver: resolver)
+            }
+            let version = cache.version.load(ordering: .acquiring)
+            let value = await scopeResolve(factory, resolver: resolver)
+            slot.inline(value, from: cache, version: version)
+            return value
+        }
+        if !hasTaskLocalContext && fatalErrorOnResolve {
             fatalError("Tried to resolve dependency: \(String(describing: D.self)) when container was set to fatal error on resolution. This is likely because tests executed a task that did not have the container context. This often happens on a detached task. Please use `Container.current` and `withContainer` to add container information back to a detached task. Called from \(file):\(line) in \(function). It's also possible you just didn't use `withTestContainer` around a test that needed it and now have test interference from tests that do use that.")
         }
-        if let currentResolver = storage(for: factory)?.asyncRegistrations.currentResolver() {
-            return await factory.scope.resolve(resolver: currentResolver)
+        if let currentResolver = registry.storage(for: factory)?.registrations.currentResolver {
+            return await scopeResolve(factory, resolver: currentResolver)
         }
-        // If no resolver found and we have a parent, delegate to parent's resolve method
+        // If no resolver found, delegate to the closest ancestor that can resolve it
         if let parent = parent {
-            return await parent.resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
+            return await resolvingAncestor(for: factory, from: parent).resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
         }
         // Otherwise use the factory's default resolver
-        return await factory.scope.resolve(resolver: factory.resolver)
+        return await scopeResolve(factory, resolver: factory.resolver)
     }
 
     func resolve<D>(factory: AsyncThrowingFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) async throws -> D {
-        if fatalErrorOnResolve && !hasTaskLocalContext {
+        let registry = self.registry.load(ordering: .acquiring)
+        if let slot = registry.frozen?[factory.slot] {
+            // Direct calls run with this container as the current one, so its cache entry is what the scope would return.
+            if !hasTaskLocalContext, let value = slot.inlinedValue(as: D.self) {
+                return value
+            }
+            let resolver = slot.resolver(for: factory) ?? factory.resolver
+            guard !hasTaskLocalContext, let cache = slot.inliningCache(for: factory) else {
+                return try await scopeResolve(factory, resolver: resolver)
+            }
+            let version = cache.version.load(ordering: .acquiring)
+            let value = try await scopeResolve(factory, resolver: resolver)
+            slot.inline(value, from: cache, version: version)
+            return value
+        }
+        if !hasTaskLocalContext && fatalErrorOnResolve {
             fatalError("Tried to resolve dependency: \(String(describing: D.self)) when container was set to fatal error on resolution. This is likely because tests executed a task that did not have the container context. This often happens on a detached task. Please use `Container.current` and `withContainer` to add container information back to a detached task. Called from \(file):\(line) in \(function). It's also possible you just didn't use `withTestContainer` around a test that needed it and now have test interference from tests that do use that.")
         }
-        if let currentResolver = storage(for: factory)?.asyncThrowingRegistrations.currentResolver() {
-            return try await factory.scope.resolve(resolver: currentResolver)
+        if let currentResolver = registry.storage(for: factory)?.registrations.currentResolver {
+            return try await scopeResolve(factory, resolver: currentResolver)
         }
-        // If no resolver found and we have a parent, delegate to parent's resolve method
+        // If no resolver found, delegate to the closest ancestor that can resolve it
         if let parent = parent {
-            return try await parent.resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
+            return try await resolvingAncestor(for: factory, from: parent).resolve(factory: factory, hasTaskLocalContext: true, file: file, line: line, function: function)
         }
         // Otherwise use the factory's default resolver
-        return try await factory.scope.resolve(resolver: factory.resolver)
+        return try await scopeResolve(factory, resolver: factory.resolver)
     }
 
-    func addResolver<D>(for factory: SyncFactory<D>, resolver: @escaping SyncFactory<D>.Resolver) {
-        register(factory: factory).syncRegistrations.add(resolver: resolver)
+    /// Returns the first container, starting at `parent`, whose `resolve` would handle `factory`.
+    ///
+    /// That is the closest ancestor with a registration for the factory, a `TestContainer`
+    /// (which never falls back to its parent), or the root. The answer is memoized per slot and
+    /// stays valid until a registration changes somewhere in this container's hierarchy, so deep
+    /// hierarchies resolve in constant time instead of visiting every level. Registrations in
+    /// other hierarchies, such as parallel tests' containers, and cache clears leave it alone.
+    private func resolvingAncestor<F: _Factory>(for factory: F, from parent: Container) -> Container {
+        // Load the version before walking: a registration published after this point
+        // bumps it again and invalidates whatever we memoize below.
+        let version = hierarchy.registrations.load(ordering: .acquiring)
+        var memo = lineage.load(ordering: .acquiring)
+        if let memo, memo.version == version, let ancestor = memo.ancestor(at: factory.slot) {
+            return ancestor
+        }
+        var ancestor = parent
+        while let next = ancestor.parent,
+              !(ancestor is TestContainer),
+              ancestor.storage(for: factory)?.registrations.isEmpty ?? true {
+            ancestor = next
+        }
+        if memo?.version != version {
+            // A racing walk may install its own memo for this version; losing either one only costs a walk.
+            let fresh = Lineage(version: version)
+            lineage.store(fresh, ordering: .releasing)
+            memo = fresh
+        }
+        memo?.memoize(ancestor, at: factory.slot)
+        return ancestor
     }
 
-    func addResolver<D>(for factory: SyncThrowingFactory<D>, resolver: @escaping SyncThrowingFactory<D>.Resolver) {
-        register(factory: factory).syncThrowingRegistrations.add(resolver: resolver)
+    func addResolver<F: _Factory>(for factory: F, resolver: F.Resolver) {
+        updateStorage(for: factory) { $0.registrations.add(resolver: resolver) }
     }
 
-    func addResolver<D>(for factory: AsyncFactory<D>, resolver: @escaping AsyncFactory<D>.Resolver) {
-        register(factory: factory).asyncRegistrations.add(resolver: resolver)
+    func popResolver(for factory: some _Factory) {
+        updateStorage(for: factory, creatingIfNeeded: false) { $0.registrations.pop() }
     }
 
-    func addResolver<D>(for factory: AsyncThrowingFactory<D>, resolver: @escaping AsyncThrowingFactory<D>.Resolver) {
-        register(factory: factory).asyncThrowingRegistrations.add(resolver: resolver)
+    func useProduction<F: _Factory>(on factory: F) {
+        updateStorage(for: factory) { $0.useProduction = true }
     }
 
-    func popResolver(for factory: some _Factory) {
-        let storage = storage(for: factory)
-        storage?.syncRegistrations.pop()
-        storage?.syncThrowingRegistrations.pop()
-        storage?.asyncRegistrations.pop()
-        storage?.asyncThrowingRegistrations.pop()
+    /// Copies the factory's storage, applies `update` to the copy and publishes a new registry snapshot.
+    ///
+    /// Published `Storage` instances are never mutated, so readers that loaded an older snapshot keep
+    /// seeing a consistent registration stack. Storage that ends up empty is dropped from the snapshot
+    /// rather than kept around, so a container only holds records for factories it actually overrides.
+    private func updateStorage<F: _Factory>(for factory: F, creatingIfNeeded: Bool = true, _ update: (Storage<F>) -> Void) {
+        lock.protect {
+            let current = registry.load(ordering: .relaxed)
+            let storage: Storage<F>
+            if let existing = current[factory.slot] {
+                storage = unsafeDowncast(existing, to: Storage<F>.self).copy()
+            } else if creatingIfNeeded {
+                storage = Storage(factory: factory)
+            } else {
+                return
+            }
+            update(storage)
+            registry.store(current.setting(storage.isEmpty ? nil : storage, at: factory.slot), ordering: .releasing)
+            hierarchy.registrations.wrappingIncrement(ordering: .releasing)
+            _resolutionGeneration.wrappingIncrement(ordering: .releasing)
+        }
     }
+}
 
-    @discardableResult func register<F: _Factory>(factory: F) -> Storage<F> {
-        lock.protect {
-            if let storage = storage[factory] as? Storage<F> {
+extension Container {
+    /// An immutable snapshot of a container's per-factory storage.
+    ///
+    /// Storage is indexed by the factory's `slot`, so a lookup is an array index rather than a hash.
+    /// A new snapshot is published on every registration change; resolution only ever loads the current one.
+    ///
+    /// Slots are handed out to every factory ever created and never reused, so a container that
+    /// overrides a few factories among hundreds would copy an array as long as the highest slot on
+    /// every registration. Once the populated slots are that sparse, the snapshot keys its storage
+    /// by slot in a dictionary instead.
+    final class Registry: AtomicReference, @unchecked Sendable {
+        /// Shared by every container until its first registration.
+        static let empty = Registry(layout: .dense([]), count: 0, span: 0)
+
+        private enum Layout {
+            case dense(ContiguousArray<StorageBase?>)
+            case sparse([Int: StorageBase])
+        }
+
+        private let layout: Layout
+        // The number of populated slots, and an upper bound on one past the highest of them.
+        private let count: Int
+        private let span: Int
+        /// The resolution table of a frozen container, or `nil` while it is mutable.
+        let frozen: ResolutionTable?
+
+        private init(layout: Layout, count: Int, span: Int, frozen: ResolutionTable? = nil) {
+            self.layout = layout
+            self.count = count
+            self.span = span
+            self.frozen = frozen
+        }
+
+        subscript(slot: Int) -> StorageBase? {
+            switch layout {
+            case .dense(let storage): slot < storage.count ? storage[slot] : nil
+            case .sparse(let storage): storage[slot]
+            }
+        }
+
+        func storage<F: _Factory>(for factory: F) -> Storage<F>? {
+            self[factory.slot].map { unsafeDowncast($0, to: Storage<F>.self) }
+        }
+
+        /// A registry with `newStorage` at `slot`. Changing a registration always thaws.
+        func setting(_ newStorage: StorageBase?, at slot: Int) -> Registry {
+            let count = self.count + (newStorage == nil ? 0 : 1) - (self[slot] == nil ? 0 : 1)
+            let span = newStorage == nil ? self.span : max(self.span, slot + 1)
+            // Dense while copying the array costs no more than a few entries per populated slot.
+            if span <= max(64, 4 * count) {
+                var storage = denseStorage(span: span)
+                storage[slot] = newStorage
+                return Registry(layout: .dense(storage), count: count, span: span)
+            }
+            var storage = sparseStorage()
+            storage[slot] = newStorage
+            return Registry(layout: .sparse(storage), count: count, span: span)
+        }
+
+        private func denseStorage(span: Int) -> ContiguousArray<StorageBase?> {
+            switch layout {
+            case .dense(var storage):
+                if storage.count < span {
+                    storage.append(contentsOf: repeatElement(nil, count: span - storage.count))
+                }
                 return storage
-            } else {
-                let newStorage = Storage(factory: factory)
-                storage[factory] = newStorage
-                return newStorage
+            case .sparse(let entries):
+                var storage = ContiguousArray<StorageBase?>(repeating: nil, count: span)
+                for (slot, entry) in entries {
+                    storage[slot] = entry
+                }
+                return storage
+            }
+        }
+
+        private func sparseStorage() -> [Int: StorageBase] {
+            switch layout {
+            case .dense(let storage):
+                var entries = [Int: StorageBase](minimumCapacity: count + 1)
+                for (slot, entry) in storage.enumerated() {
+                    entries[slot] = entry
+                }
+                return entries
+            case .sparse(let entries):
+                return entries
             }
         }
+
+        func freezing() -> Registry {
+            let thawed = thawed()
+            return Registry(layout: layout, count: count, span: span, frozen: ResolutionTable(registry: thawed))
+        }
+
+        func thawed() -> Registry {
+            frozen == nil ? self : Registry(layout: layout, count: count, span: span)
+        }
     }
 
-    func useProduction<F: _Factory>(on factory: F) {
-        guard let storage = storage(for: factory) else {
-            preconditionFailure("Factory not registered! That should've happened on factory init")
+    /// The registration version shared by the containers of one hierarchy.
+    final class HierarchyVersion: @unchecked Sendable {
+        let registrations = ManagedAtomic(0)
+    }
+
+    /// A memo of the ancestor that resolves each factory slot for a container, valid for one
+    /// version of the container's hierarchy.
+    ///
+    /// Entries are mapped by slot onto a small fixed buffer of atomic references and replaced in
+    /// place, so memoizing another slot never copies the memo. Slots that collide take turns.
+    final class Lineage: AtomicReference, @unchecked Sendable {
+        private static let capacity = 16
+
+        private final class Entry: AtomicReference, @unchecked Sendable {
+            let slot: Int
+            let ancestor: Container
+
+            init(slot: Int, ancestor: Container) {
+                self.slot = slot
+                self.ancestor = ancestor
+            }
+        }
+
+        let version: Int
+        private let entries: UnsafeMutablePointer<UnsafeAtomic<Entry?>.Storage>
+
+        init(version: Int) {
+            self.version = version
+            entries = .allocate(capacity: Self.capacity)
+            entries.initialize(repeating: .init(nil), count: Self.capacity)
+        }
+
+        deinit {
+            for index in 0..<Self.capacity {
+                _ = (entries + index).move().dispose()
+            }
+            entries.deallocate()
+        }
+
+        private func entry(for slot: Int) -> UnsafeAtomic<Entry?> {
+            UnsafeAtomic(at: entries + slot % Self.capacity)
+        }
+
+        func ancestor(at slot: Int) -> Container? {
+            guard let entry = entry(for: slot).load(ordering: .acquiring), entry.slot == slot else { return nil }
+            return entry.ancestor
+        }
+
+        func memoize(_ ancestor: Container, at slot: Int) {
+            entry(for: slot).store(Entry(slot: slot, ancestor: ancestor), ordering: .releasing)
+        }
+    }
+
+    final class BoundCacheReference {
+        weak var cache: (any ContainerBoundCache)?
+
+        init(_ cache: any ContainerBoundCache) {
+            self.cache = cache
         }
-        storage.useProduction = true
     }
-}
 
-extension Container {
     class StorageBase { }
 
     final class Storage<Factory: _Factory>: StorageBase, @unchecked Sendable {
-        private let _useProduction = ManagedAtomic(false)
-        var useProduction: Bool {
-            get { _useProduction.load(ordering: .sequentiallyConsistent) }
-            set { _useProduction.store(newValue, ordering: .sequentiallyConsistent) }
+        // Only mutated on a fresh copy inside `Container.updateStorage`, before it is published.
+        var useProduction = false
+        var registrations = Registrations<Factory.Resolver>()
+
+        var isEmpty: Bool {
+            !useProduction && registrations.isEmpty
         }
-        let syncRegistrations = SyncRegistrations<Factory.Dependency>()
-        let syncThrowingRegistrations = SyncThrowingRegistrations<Factory.Dependency>()
-        let asyncRegistrations = AsyncRegistrations<Factory.Dependency>()
-        let asyncThrowingRegistrations = AsyncThrowingRegistrations<Factory.Dependency>()
 
         init(factory: Factory) { }
+
+        private init(copying other: Storage) {
+            useProduction = other.useProduction
+            registrations = other.registrations
+        }
+
+        func copy() -> Storage {
+            Storage(copying: self)
+        }
     }
 }
@@ -0,0 +1,68 @@
+//
+//  ContainerPool.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Atomics
+
+/// Recycles the child containers created by ``withNestedContainer(operation:)-7glsq``.
+///
+/// A child is only returned to the pool when nothing else references it once the operation
+/// returns. Anything that captured it (an unstructured task, a ``BoundResolver``, a request
+/// store) keeps it alive and it is released normally instead, so a recycled container is never
+/// observable from its previous use.
+///
+/// The free list is a lock-free stack, so nested containers opened concurrently never queue
+/// behind one another.
+final class ContainerPool: Sendable {
+    private final class Node: AtomicReference, @unchecked Sendable {
+        let container: Container
+        let next: Node?
+        let depth: Int
+
+        init(container: Container, next: Node?) {
+            self.container = container
+            self.next = next
+            depth = (next?.depth ?? 0) + 1
+        }
+    }
+
+    static let shared = ContainerPool(capacity: 64)
+
+    private let capacity: Int
+    // Every push allocates a new node and a popping thread retains the node it loaded, so a
+    // compare-exchange on the top can't be fooled by a node being popped and pushed again.
+    private let top = ManagedAtomic<Node?>(nil)
+
+    init(capacity: Int) {
+        self.capacity = capacity
+    }
+
+    func take(parent: Container) -> Container {
+        var current = top.load(ordering: .acquiring)
+        while let node = current {
+            let (exchanged, original) = top.compareExchange(expected: node, desired: node.next, ordering: .acquiringAndReleasing)
+            if exchanged {
+                node.container.parent = parent
+                return node.container
+            }
+            current = original
+        }
+        return Container(parent: parent)
+    }
+
+    func recycle(_ container: inout Container) {
+        guard isKnownUniquelyReferenced(&container) else { return }
+        container.recycle()
+        var current = top.load(ordering: .acquiring)
+        while (current?.depth ?? 0) < capacity {
+            let (exchanged, original) = top.compareExchange(expected: current,
+                                                            desired: Node(container: container, next: current),
+                                                            ordering: .acquiringAndReleasing)
+            if exchanged { return }
+            current = original
+        }
+    }
+}
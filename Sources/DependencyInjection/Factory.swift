@@ -7,12 +7,29 @@
 
 import Atomics
 
+private let _nextFactorySlot = ManagedAtomic<Int>(0)
+
+/// Returns the next unused factory slot.
+///
+/// Every factory gets a unique, monotonically assigned slot when it is created. Containers use
+/// it to index their storage instead of hashing the factory. Slots are never reused, so
+/// ``Container/Registry`` switches to sparse storage once its overrides are few and far apart.
+func makeFactorySlot() -> Int {
+    _nextFactorySlot.loadThenWrappingIncrement(ordering: .relaxed)
+}
+
+/// The number of slots handed out so far; every existing factory's slot is below it.
+func factorySlotCount() -> Int {
+    _nextFactorySlot.load(ordering: .relaxed)
+}
+
 protocol _Factory: AnyObject, Hashable, Sendable {
     associatedtype Dependency
     associatedtype Resolver
 
     var resolver: Resolver { get }
     var scope: Scope { get }
+    var slot: Int { get }
 
     init(scope: Scope, resolver: Resolver)
 
@@ -56,10 +73,11 @@ public final class SyncFactory<Dependency>: _Factory, @unchecked Sendable {
     /// The scope that controls instance lifetime for this factory.
     public let scope: Scope
     let resolver: Resolver
+    let slot = makeFactorySlot()
     init(scope: Scope, resolver: @escaping Resolver) {
         self.scope = scope
         self.resolver = resolver
-        Container.default.register(factory: self)
+        CachedFactories.record(self)
     }
 
     /// Resolves and returns the dependency using the current container context.
@@ -137,11 +155,12 @@ public final class SyncThrowingFactory<Dependency>: _Factory, @unchecked Sendabl
     /// The scope that controls instance lifetime for this factory.
     public let scope: Scope
     let resolver: Resolver
+    let slot = makeFactorySlot()
 
     init(scope: Scope, resolver: @escaping Resolver) {
         self.scope = scope
         self.resolver = resolver
-        Container.default.register(factory: self)
+        CachedFactories.record(self)
     }
 
     /// Resolves and returns the dependency, or throws if the resolver fails.
@@ -205,10 +224,11 @@ public final class AsyncFactory<Dependency: Sendable>: _Factory, @unchecked Send
     /// The scope that controls instance lifetime for this factory.
     public let scope: Scope
     let resolver: Resolver
+    let slot = makeFactorySlot()
     init(scope: Scope, resolver: @escaping Resolver) {
         self.scope = scope
         self.resolver = resolver
-        Container.default.register(factory: self)
+        CachedFactories.record(self)
     }
 
     /// Resolves and returns the dependency asynchronously.
@@ -269,10 +289,11 @@ public final class AsyncThrowingFactory<Dependency: Sendable>: _Factory, @unchec
     /// The scope that controls instance lifetime for this factory.
     public let scope: Scope
     let resolver: Resolver
+    let slot = makeFactorySlot()
     init(scope: Scope, resolver: @escaping Resolver) {
         self.scope = scope
         self.resolver = resolver
-        Container.default.register(factory: self)
+        CachedFactories.record(self)
     }
 
     /// Resolves and returns the dependency asynchronously, or throws if the resolver fails.
@@ -0,0 +1,316 @@
+//
+//  Instrumentation.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+import Atomics
+#if canImport(os)
+import os
+#endif
+
+/// Receives an event for every dependency resolution while installed with
+/// ``ResolutionInstrumentation/install(_:)``.
+///
+/// Observers are called synchronously on the resolving thread, after the scope has produced
+/// its value, so they should do as little work as possible.
+public protocol ResolutionObserver: AnyObject, Sendable {
+    func didResolve(_ event: ResolutionEvent)
+}
+
+/// A single dependency resolution, as reported to a ``ResolutionObserver``.
+public struct ResolutionEvent: Sendable {
+    /// Whether the resolving scope served the value from its cache.
+    public enum CacheOutcome: String, Sendable {
+        /// The scope does not cache (for example ``UniqueScope``).
+        case uncached
+        /// A cached value was returned, or an in-flight async resolution was joined.
+        case hit
+        /// The scope ran the resolver and cached its result.
+        case miss
+    }
+
+    /// Identifies the factory that was resolved.
+    public let factoryID: ObjectIdentifier
+    /// The type of the resolved dependency.
+    public let dependencyType: any Any.Type
+    public let cacheOutcome: CacheOutcome
+    /// How many parent links were followed from ``Container/current`` to the resolving container.
+    public let depth: Int
+    /// Time spent in the scope, including the resolver when it ran.
+    public let duration: Duration
+    /// Time spent in the resolver, or `nil` when the scope did not run it.
+    public let resolverDuration: Duration?
+}
+
+/// Opt-in instrumentation of dependency resolution.
+///
+/// Nothing is recorded until an observer is installed. While none is, resolution pays a single
+/// relaxed load of a flag and a branch before handing the resolver to its scope.
+///
+/// ```swift
+/// let metrics = ResolutionMetrics()
+/// ResolutionInstrumentation.install(metrics)
+/// // ...
+/// print(metrics.snapshot())
+/// ```
+public enum ResolutionInstrumentation {
+    private final class Installation: AtomicReference, Sendable {
+        let observer: any ResolutionObserver
+
+        init(_ observer: any ResolutionObserver) {
+            self.observer = observer
+        }
+    }
+
+    private static let installation = ManagedAtomic<Installation?>(nil)
+    // Checked before `installation`, whose load retains the installation: a plain flag keeps the
+    // uninstalled path to a relaxed load that writes nothing shared.
+    private static let isInstalled = ManagedAtomic(false)
+
+    /// Routes every subsequent resolution event to `observer`, replacing any installed observer.
+    public static func install(_ observer: some ResolutionObserver) {
+        installation.store(Installation(observer), ordering: .releasing)
+        isInstalled.store(true, ordering: .releasing)
+    }
+
+    /// Stops reporting resolution events.
+    public static func uninstall() {
+        isInstalled.store(false, ordering: .releasing)
+        installation.store(nil, ordering: .releasing)
+    }
+
+    /// Whether an observer is installed. Memoized and inlined values are bypassed while one is,
+    /// so it sees every resolution.
+    static var isObserving: Bool {
+        isInstalled.load(ordering: .relaxed)
+    }
+
+    static var observer: (any ResolutionObserver)? {
+        guard isObserving else { return nil }
+        return installation.load(ordering: .acquiring)?.observer
+    }
+}
+
+/// Aggregates resolution events per factory.
+public final class ResolutionMetrics: ResolutionObserver, @unchecked Sendable {
+    public struct FactoryMetrics: Sendable {
+        public let dependencyType: any Any.Type
+        public internal(set) var resolutions = 0
+        public internal(set) var cacheHits = 0
+        public internal(set) var cacheMisses = 0
+        public internal(set) var totalDuration = Duration.zero
+        public internal(set) var totalResolverDuration = Duration.zero
+        public internal(set) var maxResolverDuration = Duration.zero
+        public internal(set) var maxDepth = 0
+
+        /// The fraction of cached resolutions served from the cache, or `nil` for uncached factories.
+        public var cacheHitRate: Double? {
+            let cached = cacheHits + cacheMisses
+            return cached == 0 ? nil : Double(cacheHits) / Double(cached)
+        }
+    }
+
+    private let lock = NSRecursiveLock()
+    private var metrics = [ObjectIdentifier: FactoryMetrics]()
+
+    public init() { }
+
+    public func didResolve(_ event: ResolutionEvent) {
+        lock.protect {
+            var entry = metrics[event.factoryID] ?? FactoryMetrics(dependencyType: event.dependencyType)
+            entry.resolutions += 1
+            switch event.cacheOutcome {
+            case .uncached: break
+            case .hit: entry.cacheHits += 1
+            case .miss: entry.cacheMisses += 1
+            }
+            entry.totalDuration += event.duration
+            if let resolverDuration = event.resolverDuration {
+                entry.totalResolverDuration += resolverDuration
+                entry.maxResolverDuration = max(entry.maxResolverDuration, resolverDuration)
+            }
+            entry.maxDepth = max(entry.maxDepth, event.depth)
+            metrics[event.factoryID] = entry
+        }
+    }
+
+    /// The metrics recorded so far, keyed by factory.
+    public func snapshot() -> [ObjectIdentifier: FactoryMetrics] {
+        lock.protect { metrics }
+    }
+
+    /// The metrics recorded so far for `factory`, if it has been resolved.
+    public func metrics(for factory: AnyObject) -> FactoryMetrics? {
+        lock.protect { metrics[ObjectIdentifier(factory)] }
+    }
+
+    public func reset() {
+        lock.protect { metrics.removeAll() }
+    }
+}
+
+#if canImport(os)
+/// Emits a signpost for every resolution so it can be inspected in Instruments.
+public final class SignpostResolutionObserver: ResolutionObserver, @unchecked Sendable {
+    private let signposter: OSSignposter
+
+    public init(subsystem: String = "DependencyInjection", category: String = "Resolution") {
+        signposter = OSSignposter(subsystem: subsystem, category: category)
+    }
+
+    public func didResolve(_ event: ResolutionEvent) {
+        guard signposter.isEnabled else { return }
+        let type = String(describing: event.dependencyType)
+        let resolverNanoseconds = event.resolverDuration.map(\.nanosecondCount) ?? 0
+        signposter.emitEvent("Resolve", "\(type, privacy: .public) \(event.cacheOutcome.rawValue, privacy: .public) depth=\(event.depth) ns=\(event.duration.nanosecondCount) resolverNs=\(resolverNanoseconds)")
+    }
+}
+#endif
+
+// Times the resolver when the scope runs it. The resolver may run on another task (async cached
+// scopes), so the result is published atomically; -1 means it never ran.
+private final class ResolverTimer: Sendable {
+    private let nanoseconds = ManagedAtomic<Int64>(-1)
+
+    var duration: Duration? {
+        let value = nanoseconds.load(ordering: .acquiring)
+        return value < 0 ? nil : .nanoseconds(value)
+    }
+
+    func record(since start: ContinuousClock.Instant) {
+        nanoseconds.store(start.duration(to: .now).nanosecondCount, ordering: .releasing)
+    }
+}
+
+extension Container {
+    // Every path that hands a resolver to a factory's scope goes through one of these. When no
+    // observer is installed and lock diagnostics are compiled out they reduce to the plain
+    // `scope.resolve` call.
+
+    func scopeResolve<D>(_ factory: SyncFactory<D>, resolver: @escaping SyncFactory<D>.Resolver) -> D {
+        #if DI_LOCK_DIAGNOSTICS
+        LockDiagnostics.$resolvingFactory.withValue(ObjectIdentifier(factory)) { observedResolve(factory, resolver: resolver) }
+        #else
+        observedResolve(factory, resolver: resolver)
+        #endif
+    }
+
+    func scopeResolve<D>(_ factory: SyncThrowingFactory<D>, resolver: @escaping SyncThrowingFactory<D>.Resolver) throws -> D {
+        #if DI_LOCK_DIAGNOSTICS
+        try LockDiagnostics.$resolvingFactory.withValue(ObjectIdentifier(factory)) { try observedResolve(factory, resolver: resolver) }
+        #else
+        try observedResolve(factory, resolver: resolver)
+        #endif
+    }
+
+    func scopeResolve<D>(_ factory: AsyncFactory<D>, resolver: @escaping AsyncFactory<D>.Resolver) async -> D {
+        #if DI_LOCK_DIAGNOSTICS
+        await LockDiagnostics.$resolvingFactory.withValue(ObjectIdentifier(factory)) { await observedResolve(factory, resolver: resolver) }
+        #else
+        await observedResolve(factory, resolver: resolver)
+        #endif
+    }
+
+    func scopeResolve<D>(_ factory: AsyncThrowingFactory<D>, resolver: @escaping AsyncThrowingFactory<D>.Resolver) async throws -> D {
+        #if DI_LOCK_DIAGNOSTICS
+        try await LockDiagnostics.$resolvingFactory.withValue(ObjectIdentifier(factory)) { try await observedResolve(factory, resolver: resolver) }
+        #else
+        try await observedResolve(factory, resolver: resolver)
+        #endif
+    }
+
+    private func observedResolve<D>(_ factory: SyncFactory<D>, resolver: @escaping SyncFactory<D>.Resolver) -> D {
+        guard let observer = ResolutionInstrumentation.observer else {
+            return factory.scope.resolve(resolver: resolver)
+        }
+        let timer = ResolverTimer()
+        let start = ContinuousClock.now
+        defer { report(factory, to: observer, start: start, timer: timer) }
+        return factory.scope.resolve {
+            let start = ContinuousClock.now
+            defer { timer.record(since: start) }
+            return resolver()
+        }
+    }
+
+    private func observedResolve<D>(_ factory: SyncThrowingFactory<D>, resolver: @escaping SyncThrowingFactory<D>.Resolver) throws -> D {
+        guard let observer = ResolutionInstrumentation.observer else {
+            return try factory.scope.resolve(resolver: resolver)
+        }
+        let timer = ResolverTimer()
+        let start = ContinuousClock.now
+        defer { report(factory, to: observer, start: start, timer: timer) }
+        return try factory.scope.resolve {
+            let start = ContinuousClock.now
+            defer { timer.record(since: start) }
+            return try resolver()
+        }
+    }
+
+    private func observedResolve<D>(_ factory: AsyncFactory<D>, resolver: @escaping AsyncFactory<D>.Resolver) async -> D {
+        guard let observer = ResolutionInstrumentation.observer else {
+            return await factory.scope.resolve(resolver: resolver)
+        }
+        let timer = ResolverTimer()
+        let start = ContinuousClock.now
+        defer { report(factory, to: observer, start: start, timer: timer) }
+        return await factory.scope.resolve { @Sendable in
+            let start = ContinuousClock.now
+            defer { timer.record(since: start) }
+            return await resolver()
+        }
+    }
+
+    private func observedResolve<D>(_ factory: AsyncThrowingFactory<D>, resolver: @escaping AsyncThrowingFactory<D>.Resolver) async throws -> D {
+        guard let observer = ResolutionInstrumentation.observer else {
+            return try await factory.scope.resolve(resolver: resolver)
+        }
+        let timer = ResolverTimer()
+        let start = ContinuousClock.now
+        defer { report(factory, to: observer, start: start, timer: timer) }
+        return try await factory.scope.resolve { @Sendable in
+            let start = ContinuousClock.now
+            defer { timer.record(since: start) }
+            return try await resolver()
+        }
+    }
+
+    private func report<F: _Factory>(_ factory: F, to observer: any ResolutionObserver, start: ContinuousClock.Instant, timer: ResolverTimer) {
+        let duration = start.duration(to: .now)
+        let resolverDuration = timer.duration
+        let cacheOutcome: ResolutionEvent.CacheOutcome
+        if factory.scope is ScopeWithCache {
+            cacheOutcome = resolverDuration == nil ? .hit : .miss
+        } else {
+            cacheOutcome = .uncached
+        }
+        observer.didResolve(ResolutionEvent(factoryID: ObjectIdentifier(factory),
+                                            dependencyType: F.Dependency.self,
+                                            cacheOutcome: cacheOutcome,
+                                            depth: depth(from: Container.current),
+                                            duration: duration,
+                                            resolverDuration: resolverDuration))
+    }
+
+    /// The number of parent links from `container` to `self`, or 0 if `self` is not one of its ancestors.
+    private func depth(from container: Container) -> Int {
+        var depth = 0
+        var candidate: Container? = container
+        while let current = candidate {
+            if current === self { return depth }
+            depth += 1
+            candidate = current.parent
+        }
+        return 0
+    }
+}
+
+extension Duration {
+    fileprivate var nanosecondCount: Int64 {
+        let (seconds, attoseconds) = components
+        return seconds * 1_000_000_000 + attoseconds / 1_000_000_000
+    }
+}
@@ -10,7 +10,11 @@ import Foundation
 #if canImport(Darwin)
 @_cdecl("di_transformBlock")
 func transformBlock(block: @escaping @convention(block) () -> Void) -> @convention(block) () -> Void {
+    // Every hooked dispatch pays this task-local read. Work dispatched from the default
+    // container would run in it anyway, so that case returns the original block and skips
+    // allocating a wrapper; any other container gets one.
     let container = Container.current
+    guard container !== Container.default else { return block }
     return {
         withContainer(container) {
             block()
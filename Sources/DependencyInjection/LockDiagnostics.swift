@@ -0,0 +1,238 @@
+//
+//  LockDiagnostics.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+
+/// Acquisition counts and timings for a set of lock acquisitions.
+public struct LockStatistics: Sendable {
+    public internal(set) var acquisitions = 0
+    /// Acquisitions that found the lock held by another thread and had to wait.
+    public internal(set) var contendedAcquisitions = 0
+    /// Time spent waiting for the lock across all contended acquisitions.
+    public internal(set) var totalWait = Duration.zero
+    public internal(set) var maxWait = Duration.zero
+    /// Time the lock was held across all acquisitions. Recursive acquisitions overlap their outer one.
+    public internal(set) var totalHold = Duration.zero
+    public internal(set) var maxHold = Duration.zero
+
+    /// The fraction of acquisitions that were contended, or `nil` if the lock was never taken.
+    public var contentionRate: Double? {
+        acquisitions == 0 ? nil : Double(contendedAcquisitions) / Double(acquisitions)
+    }
+
+    mutating func merge(_ other: LockStatistics) {
+        acquisitions += other.acquisitions
+        contendedAcquisitions += other.contendedAcquisitions
+        totalWait += other.totalWait
+        maxWait = max(maxWait, other.maxWait)
+        totalHold += other.totalHold
+        maxHold = max(maxHold, other.maxHold)
+    }
+}
+
+/// Opt-in statistics for every lock the library takes.
+///
+/// Recording is a build mode: build with the `DI_LOCK_DIAGNOSTICS` environment variable set
+/// (for example `DI_LOCK_DIAGNOSTICS=1 swift test`) and every library lock counts its
+/// acquisitions, contended acquisitions, wait time and hold time. Otherwise the locks are plain
+/// `NSRecursiveLock`s, ``isEnabled`` is `false` and snapshots are empty.
+///
+/// Statistics are grouped by lock site (`"CachedScope"`, `"Container"`, `"StrongCache"`, ...) and by
+/// the factory being resolved when the lock was taken:
+///
+/// ```swift
+/// LockDiagnostics.reset()
+/// runLoadTest()
+/// let snapshot = LockDiagnostics.snapshot()
+/// for (site, statistics) in snapshot.sites.sorted(by: { $0.value.totalWait > $1.value.totalWait }) {
+///     print(site, statistics.contendedAcquisitions, statistics.totalWait)
+/// }
+/// print(snapshot.statistics(for: Container.database) as Any)
+/// ```
+public enum LockDiagnostics {
+    /// The statistics recorded up to the moment ``LockDiagnostics/snapshot()`` was called.
+    public struct Snapshot: Sendable {
+        /// Statistics per lock site, across every instance of that lock.
+        public let sites: [String: LockStatistics]
+        /// Statistics per factory, for the locks taken while that factory was resolving.
+        public let factories: [ObjectIdentifier: LockStatistics]
+
+        /// The statistics for the locks taken while resolving `factory`, if any were.
+        public func statistics(for factory: AnyObject) -> LockStatistics? {
+            factories[ObjectIdentifier(factory)]
+        }
+    }
+
+    /// Whether this build records lock statistics.
+    public static var isEnabled: Bool {
+        #if DI_LOCK_DIAGNOSTICS
+        true
+        #else
+        false
+        #endif
+    }
+
+    /// Collects the statistics of every live lock and of those already deallocated.
+    public static func snapshot() -> Snapshot {
+        #if DI_LOCK_DIAGNOSTICS
+        var sites = [String: LockStatistics]()
+        var factories = [ObjectIdentifier: LockStatistics]()
+        for record in LockRegistry.records() {
+            for (factory, statistics) in record.statistics {
+                sites[record.site, default: LockStatistics()].merge(statistics)
+                if let factory {
+                    factories[factory, default: LockStatistics()].merge(statistics)
+                }
+            }
+        }
+        return Snapshot(sites: sites, factories: factories)
+        #else
+        return Snapshot(sites: [:], factories: [:])
+        #endif
+    }
+
+    /// Discards everything recorded so far.
+    public static func reset() {
+        #if DI_LOCK_DIAGNOSTICS
+        LockRegistry.reset()
+        #endif
+    }
+
+    /// The factory whose resolution is running, used to attribute lock acquisitions.
+    @TaskLocal static var resolvingFactory: ObjectIdentifier?
+}
+
+/// The lock used throughout the library, identified by the site that owns it.
+///
+/// In a `DI_LOCK_DIAGNOSTICS` build it records ``LockStatistics`` for ``LockDiagnostics``;
+/// otherwise it adds nothing to `NSRecursiveLock`.
+final class TrackedLock: NSRecursiveLock {
+    #if DI_LOCK_DIAGNOSTICS
+    let site: String
+    // Only touched while the lock is held (or from deinit), so it needs no synchronization of its own.
+    private var acquiredAt = [ContinuousClock.Instant]()
+    private var attributions = [ObjectIdentifier?]()
+    fileprivate var statistics = [ObjectIdentifier?: LockStatistics]()
+
+    init(site: String) {
+        self.site = site
+        super.init()
+        LockRegistry.register(self)
+    }
+
+    deinit {
+        LockRegistry.retire(self)
+    }
+
+    override func lock() {
+        var wait: Duration?
+        if !super.try() {
+            let start = ContinuousClock.now
+            super.lock()
+            wait = start.duration(to: .now)
+        }
+        let factory = LockDiagnostics.resolvingFactory
+        acquiredAt.append(.now)
+        attributions.append(factory)
+        statistics[factory, default: LockStatistics()].recordAcquisition(waiting: wait)
+    }
+
+    override func unlock() {
+        if let start = acquiredAt.popLast(), let factory = attributions.popLast() {
+            statistics[factory, default: LockStatistics()].recordHold(start.duration(to: .now))
+        }
+        super.unlock()
+    }
+
+    /// Copies the statistics without recording the acquisition that reads them.
+    fileprivate func statisticsSnapshot() -> [ObjectIdentifier?: LockStatistics] {
+        super.lock()
+        defer { super.unlock() }
+        return statistics
+    }
+
+    fileprivate func resetStatistics() {
+        super.lock()
+        defer { super.unlock() }
+        statistics.removeAll()
+    }
+    #else
+    init(site: String) {
+        super.init()
+    }
+    #endif
+}
+
+#if DI_LOCK_DIAGNOSTICS
+extension LockStatistics {
+    fileprivate mutating func recordAcquisition(waiting wait: Duration?) {
+        acquisitions += 1
+        if let wait {
+            contendedAcquisitions += 1
+            totalWait += wait
+            maxWait = max(maxWait, wait)
+        }
+    }
+
+    fileprivate mutating func recordHold(_ hold: Duration) {
+        totalHold += hold
+        maxHold = max(maxHold, hold)
+    }
+}
+
+/// Every live ``TrackedLock``, plus the statistics of those already deallocated.
+private enum LockRegistry {
+    struct Record {
+        let site: String
+        let statistics: [ObjectIdentifier?: LockStatistics]
+    }
+
+    private final class WeakLock {
+        weak var lock: TrackedLock?
+        init(_ lock: TrackedLock) { self.lock = lock }
+    }
+
+    // A plain lock: tracking the registry's own lock would recurse into it.
+    private static let lock = NSLock()
+    private nonisolated(unsafe) static var live = [ObjectIdentifier: WeakLock]()
+    private nonisolated(unsafe) static var retired = [String: [ObjectIdentifier?: LockStatistics]]()
+
+    static func register(_ tracked: TrackedLock) {
+        lock.lock()
+        defer { lock.unlock() }
+        live[ObjectIdentifier(tracked)] = WeakLock(tracked)
+    }
+
+    static func retire(_ tracked: TrackedLock) {
+        lock.lock()
+        defer { lock.unlock() }
+        live[ObjectIdentifier(tracked)] = nil
+        for (factory, statistics) in tracked.statistics {
+            retired[tracked.site, default: [:]][factory, default: LockStatistics()].merge(statistics)
+        }
+    }
+
+    static func records() -> [Record] {
+        lock.lock()
+        let locks = live.values.compactMap(\.lock)
+        var records = retired.map { Record(site: $0.key, statistics: $0.value) }
+        lock.unlock()
+        // Each tracked lock is read after the registry lock is released, so a thread that holds one
+        // of them while creating another lock can't deadlock against the snapshot.
+        records += locks.map { Record(site: $0.site, statistics: $0.statisticsSnapshot()) }
+        return records
+    }
+
+    static func reset() {
+        lock.lock()
+        let locks = live.values.compactMap(\.lock)
+        retired.removeAll()
+        lock.unlock()
+        locks.forEach { $0.resetStatistics() }
+    }
+}
+#endif
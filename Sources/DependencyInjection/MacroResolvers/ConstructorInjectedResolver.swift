@@ -12,6 +12,9 @@
 /// lifetime of the owning object.
 ///
 /// For async factories, a `Task` is created at init and cancelled in `deinit`.
+///
+/// Properties marked `batched: true` in a ``ConstructorInjection()`` type are resolved together
+/// through one ``BoundResolver``; their async tasks all start at init and run concurrently.
 public final class ConstructorInjectedResolver<Value, Factory: Sendable>: @unchecked Sendable {
     /// The resolved dependency value, set once at init.
     public let wrappedValue: Value
@@ -43,6 +46,33 @@ public final class ConstructorInjectedResolver<Value, Factory: Sendable>: @unche
         cleanup = task.cancel
     }
 
+    /// Resolves `factory` through `resolve`, so a type's batched properties share one container lookup.
+    public init(_ factory: SyncFactory<Value>, resolvingWith resolve: BoundResolver, file: String = #file, line: UInt = #line, function: String = #function) where Factory == SyncFactory<Value> {
+        wrappedValue = resolve(factory, file: file, line: line, function: function)
+        self.factory = factory
+        cleanup = { }
+    }
+
+    public init<D>(_ factory: Factory, resolvingWith resolve: BoundResolver, file: String = #file, line: UInt = #line, function: String = #function) where Factory == SyncThrowingFactory<D>, Value == Result<D, any Error> {
+        wrappedValue = Result { try resolve(factory, file: file, line: line, function: function) }
+        self.factory = factory
+        cleanup = { }
+    }
+
+    public init<D>(_ factory: Factory, resolvingWith resolve: BoundResolver, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncFactory<D>, Value == Task<D, Never> {
+        let task = Task { await resolve(factory, file: file, line: line, function: function) }
+        wrappedValue = task
+        self.factory = factory
+        cleanup = task.cancel
+    }
+
+    public init<D>(_ factory: Factory, resolvingWith resolve: BoundResolver, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncThrowingFactory<D>, Value == Task<D, any Error> {
+        let task = Task { try await resolve(factory, file: file, line: line, function: function) }
+        wrappedValue = task
+        self.factory = factory
+        cleanup = task.cancel
+    }
+
     deinit {
         cleanup()
     }
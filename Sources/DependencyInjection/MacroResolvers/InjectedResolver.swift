@@ -5,38 +5,74 @@
 //  Created by Tyler Thompson on 7/28/25.
 //
 
+import Atomics
+
 /// The backing resolver for the ``Injected(_:)-swift.macro`` macro.
 ///
 /// You do not create this type directly. It is generated by the `@Injected` macro expansion.
 /// Each property access calls the factory through ``Container/current``, producing a fresh
 /// value every time.
 ///
+/// Pass `memoized: true` to keep the last value of a cached or shared factory in the instance.
+/// Reads then return it without resolving while the current container and every registration
+/// and cache are unchanged; registering, popping or clearing a cache anywhere invalidates it.
+///
 /// For throwing factories the `Value` is `Result<D, any Error>`.
 /// For async factories the `Value` is `Task<D, Never>` or `Task<D, any Error>`.
 public struct InjectedResolver<Value, Factory: Sendable>: Sendable {
     let factory: Factory
     let getter: @Sendable () -> Value
-    public init(_ factory: Factory, file: String = #file, line: UInt = #line, function: String = #function) where Factory == SyncFactory<Value> {
-        getter = { factory(file: file, line: line, function: function) }
+    public init(_ factory: Factory, memoized: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) where Factory == SyncFactory<Value> {
+        if memoized, let memo = ResolutionMemo<Value>(scope: factory.scope) {
+            getter = { memo.value { factory(file: file, line: line, function: function) } }
+        } else {
+            getter = { factory(file: file, line: line, function: function) }
+        }
         self.factory = factory
     }
 
-    public init<D>(_ factory: Factory, file: String = #file, line: UInt = #line, function: String = #function) where Factory == SyncThrowingFactory<D>, Value == Result<D, any Error> {
-        getter = { Result { try factory(file: file, line: line, function: function) } }
+    public init<D>(_ factory: Factory, memoized: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) where Factory == SyncThrowingFactory<D>, Value == Result<D, any Error> {
+        if memoized, let memo = ResolutionMemo<D>(scope: factory.scope) {
+            // Failures are not cached by the scope, so they are not memoized either.
+            getter = { Result { try memo.value { try factory(file: file, line: line, function: function) } } }
+        } else {
+            getter = { Result { try factory(file: file, line: line, function: function) } }
+        }
         self.factory = factory
     }
 
-    public init<D>(_ factory: Factory, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncFactory<D>, Value == Task<D, Never> {
-        getter = { Task { await factory(file: file, line: line, function: function) } }
+    public init<D>(_ factory: Factory, memoized: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncFactory<D>, Value == Task<D, Never> {
+        // Tasks are values, so shared scopes (which would need a weak reference) are not memoized.
+        if memoized, let memo = ResolutionMemo<Value>(scope: factory.scope) {
+            getter = { memo.value { Task { await factory(file: file, line: line, function: function) } } }
+        } else {
+            getter = { Task { await factory(file: file, line: line, function: function) } }
+        }
         self.factory = factory
     }
 
-    public init<D>(_ factory: Factory, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncThrowingFactory<D>, Value == Task<D, any Error> {
-        getter = { Task { try await factory(file: file, line: line, function: function) } }
+    public init<D>(_ factory: Factory, memoized: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncThrowingFactory<D>, Value == Task<D, any Error> {
+        if memoized, let memo = ResolutionMemo<Value>(scope: factory.scope) {
+            getter = {
+                memo.value {
+                    Task {
+                        do {
+                            return try await factory(file: file, line: line, function: function)
+                        } catch {
+                            // The scope retries failed resolutions; let the next read do the same.
+                            memo.forget()
+                            throw error
+                        }
+                    }
+                }
+            }
+        } else {
+            getter = { Task { try await factory(file: file, line: line, function: function) } }
+        }
         self.factory = factory
     }
 
-    /// The resolved dependency value. Calls the factory on every access.
+    /// The resolved dependency value. Calls the factory on every access unless memoized.
     public var wrappedValue: Value {
         getter()
     }
@@ -46,3 +82,76 @@ public struct InjectedResolver<Value, Factory: Sendable>: Sendable {
         factory
     }
 }
+
+/// The last value an `@Injected(memoized: true)` property resolved, stamped with the container
+/// it was resolved in and the resolution generation at the time.
+///
+/// A read is served from the memo only if the current container is the one it was stamped with
+/// and no registration or cache has changed since, which is exactly when the scope would have
+/// returned the same cached value. Values of shared scopes are held weakly, as the scope does.
+final class ResolutionMemo<Value>: @unchecked Sendable {
+    private final class Entry: AtomicReference, @unchecked Sendable {
+        weak var container: Container?
+        let incarnation: Int
+        let generation: Int
+        private let strongValue: Value?
+        private weak var weakValue: AnyObject?
+
+        init?(_ value: Value, container: Container, generation: Int, holdsWeakly: Bool) {
+            if holdsWeakly {
+                guard type(of: value as Any) is AnyClass else { return nil }
+                strongValue = nil
+                weakValue = value as AnyObject
+            } else {
+                strongValue = value
+            }
+            self.container = container
+            incarnation = container.incarnation
+            self.generation = generation
+        }
+
+        var value: Value? {
+            strongValue ?? weakValue.flatMap { $0 as? Value }
+        }
+    }
+
+    private let entry = ManagedAtomic<Entry?>(nil)
+    private let holdsWeakly: Bool
+
+    /// Creates a memo for a factory with `scope`, or `nil` if the scope does not reuse values.
+    init?(scope: Scope) {
+        switch scope {
+        // Expiring and capacity-bound caches drop values without a generation change.
+        case let cached as CachedScope where !cached.evicts: holdsWeakly = false
+        case is SharedScope: holdsWeakly = true
+        default: return nil
+        }
+    }
+
+    func value(resolving resolve: () throws -> Value) rethrows -> Value {
+        let container = Container.current
+        // Load the generation before resolving: a change published after this point bumps it
+        // again and invalidates whatever we store below.
+        let generation = _resolutionGeneration.load(ordering: .acquiring)
+        // Instrumented resolutions must be reported, so they always run.
+        guard container.memoizesResolutions, !ResolutionInstrumentation.isObserving else {
+            return try resolve()
+        }
+        if let entry = entry.load(ordering: .acquiring),
+           entry.generation == generation,
+           entry.container === container,
+           entry.incarnation == container.incarnation,
+           let value = entry.value {
+            return value
+        }
+        let value = try resolve()
+        if let resolved = Entry(value, container: container, generation: generation, holdsWeakly: holdsWeakly) {
+            entry.store(resolved, ordering: .releasing)
+        }
+        return value
+    }
+
+    func forget() {
+        entry.store(nil, ordering: .releasing)
+    }
+}
@@ -6,20 +6,34 @@
 //
 
 import Foundation
+import Atomics
 
 /// The backing resolver for the ``LazyInjected(_:)-swift.macro`` macro.
 ///
 /// You do not create this type directly. It is generated by the `@LazyInjected` macro expansion.
 /// The dependency is resolved on first property access and cached for subsequent reads.
-/// Access is thread-safe via an internal lock.
+/// Access is thread-safe: once the value is cached, a read is a single acquiring load, and only
+/// the first access takes a lock so the resolver runs exactly once.
 ///
-/// For async factories, the async task starts eagerly at init time, but the result
-/// is only read (and cached) on first property access.
+/// For async factories, the async task starts eagerly at init time by default, but the result
+/// is only read (and cached) on first property access. Pass `startsOnFirstAccess: true` to
+/// create the task on first access instead; it still resolves in the container that was current
+/// at init. Tasks are not cancelled when the owner is deallocated, since they may have escaped
+/// and still be awaited.
 public final class LazyInjectedResolver<Value, Factory: Sendable> {
+    private final class Resolved {
+        let value: Value
+
+        init(_ value: Value) {
+            self.value = value
+        }
+    }
+
     let factory: Factory
     let getter: @Sendable () -> Value
     let cleanup: () -> Void
-    private let lock = NSRecursiveLock()
+    private let resolved = ManagedAtomicLazyReference<Resolved>()
+    private let lock = TrackedLock(site: "LazyInjectedResolver")
 
     public init(_ factory: Factory, file: String = #file, line: UInt = #line, function: String = #function) where Factory == SyncFactory<Value> {
         getter = { factory(file: file, line: line, function: function) }
@@ -33,35 +47,45 @@ public final class LazyInjectedResolver<Value, Factory: Sendable> {
         cleanup = { }
     }
 
-    public init<D>(_ factory: Factory, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncFactory<D>, Value == Task<D, Never> {
-        let task = Task { await factory(file: file, line: line, function: function) }
-        getter = { task }
+    public init<D>(_ factory: Factory, startsOnFirstAccess: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncFactory<D>, Value == Task<D, Never> {
         self.factory = factory
-        cleanup = task.cancel
+        if startsOnFirstAccess {
+            let resolve = BoundResolver()
+            getter = { Task { await resolve(factory, file: file, line: line, function: function) } }
+            cleanup = { }
+        } else {
+            let task = Task { await factory(file: file, line: line, function: function) }
+            getter = { task }
+            cleanup = task.cancel
+        }
     }
 
-    public init<D>(_ factory: Factory, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncThrowingFactory<D>, Value == Task<D, any Error> {
-        let task = Task { try await factory(file: file, line: line, function: function) }
-        getter = { task }
+    public init<D>(_ factory: Factory, startsOnFirstAccess: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) where Factory == AsyncThrowingFactory<D>, Value == Task<D, any Error> {
         self.factory = factory
-        cleanup = task.cancel
+        if startsOnFirstAccess {
+            let resolve = BoundResolver()
+            getter = { Task { try await resolve(factory, file: file, line: line, function: function) } }
+            cleanup = { }
+        } else {
+            let task = Task { try await factory(file: file, line: line, function: function) }
+            getter = { task }
+            cleanup = task.cancel
+        }
     }
 
-    private var _wrappedValue: Value?
-
     /// The resolved dependency value. Resolved on first access, then cached.
     public var wrappedValue: Value {
         get {
-            lock.lock()
-            defer { lock.unlock() }
-
-            if let _wrappedValue {
-                return _wrappedValue
+            if let cached = resolved.load() {
+                return cached.value
+            }
+            // The lock only ensures the resolver runs once when first reads race.
+            return lock.protect {
+                if let cached = resolved.load() {
+                    return cached.value
+                }
+                return resolved.storeIfNilThenLoad(Resolved(getter())).value
             }
-
-            let dependency = getter()
-            _wrappedValue = dependency
-            return dependency
         }
     }
 
@@ -28,10 +28,22 @@
 /// $logger.register { FileLogger() }
 /// ```
 ///
-/// - Parameter factory: The ``SyncFactory`` to resolve from.
+/// Pass `memoized: true` to skip resolution on reads where the result can't have changed.
+/// For cached and shared factories the property keeps the last value it resolved, and returns
+/// it while the current container is the same and no registration or cache has changed since:
+///
+/// ```swift
+/// @Injected(Container.logger, memoized: true) var logger: Logger
+/// ```
+///
+/// Unique factories resolve on every read regardless.
+///
+/// - Parameters:
+///   - factory: The ``SyncFactory`` to resolve from.
+///   - memoized: Reuse the last resolved value while nothing that affects it has changed.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro Injected<T>(_ factory: SyncFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedSyncMacro")
+public macro Injected<T>(_ factory: SyncFactory<T>, memoized: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedSyncMacro")
 
 /// Injects a dependency from a throwing factory. The wrapped value type is `Result<T, any Error>`.
 ///
@@ -43,10 +55,12 @@ public macro Injected<T>(_ factory: SyncFactory<T>) = #externalMacro(module: "De
 /// }
 /// ```
 ///
-/// - Parameter factory: The ``SyncThrowingFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``SyncThrowingFactory`` to resolve from.
+///   - memoized: Reuse the last successfully resolved value while nothing that affects it has changed.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro Injected<T>(_ factory: SyncThrowingFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedSyncThrowingMacro")
+public macro Injected<T>(_ factory: SyncThrowingFactory<T>, memoized: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedSyncThrowingMacro")
 
 /// Injects a dependency from an async factory. The wrapped value type is `Task<T, Never>`.
 ///
@@ -58,17 +72,21 @@ public macro Injected<T>(_ factory: SyncThrowingFactory<T>) = #externalMacro(mod
 /// }
 /// ```
 ///
-/// - Parameter factory: The ``AsyncFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``AsyncFactory`` to resolve from.
+///   - memoized: Reuse the last resolution task of a cached factory while nothing that affects it has changed.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro Injected<T>(_ factory: AsyncFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedAsyncMacro")
+public macro Injected<T>(_ factory: AsyncFactory<T>, memoized: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedAsyncMacro")
 
 /// Injects a dependency from an async throwing factory. The wrapped value type is `Task<T, any Error>`.
 ///
-/// - Parameter factory: The ``AsyncThrowingFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``AsyncThrowingFactory`` to resolve from.
+///   - memoized: Reuse the last resolution task of a cached factory while nothing that affects it has changed.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro Injected<T>(_ factory: AsyncThrowingFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedAsyncThrowingMacro")
+public macro Injected<T>(_ factory: AsyncThrowingFactory<T>, memoized: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "InjectedAsyncThrowingMacro")
 
 // MARK: - @ConstructorInjected
 
@@ -83,33 +101,65 @@ public macro Injected<T>(_ factory: AsyncThrowingFactory<T>) = #externalMacro(mo
 /// }
 /// ```
 ///
-/// - Parameter factory: The ``SyncFactory`` to resolve from.
+/// In a type marked with ``ConstructorInjection()``, pass `batched: true` to resolve the
+/// property together with the type's other batched properties.
+///
+/// - Parameters:
+///   - factory: The ``SyncFactory`` to resolve from.
+///   - batched: Let the enclosing ``ConstructorInjection()`` type store and resolve this property.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro ConstructorInjected<T>(_ factory: SyncFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedSyncMacro")
+public macro ConstructorInjected<T>(_ factory: SyncFactory<T>, batched: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedSyncMacro")
 
 /// Injects a dependency from a throwing factory at init time. Wrapped value is `Result<T, any Error>`.
 ///
-/// - Parameter factory: The ``SyncThrowingFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``SyncThrowingFactory`` to resolve from.
+///   - batched: Let the enclosing ``ConstructorInjection()`` type store and resolve this property.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro ConstructorInjected<T>(_ factory: SyncThrowingFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedSyncThrowingMacro")
+public macro ConstructorInjected<T>(_ factory: SyncThrowingFactory<T>, batched: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedSyncThrowingMacro")
 
 /// Injects a dependency from an async factory at init time. Wrapped value is `Task<T, Never>`.
 /// The task is cancelled in `deinit`.
 ///
-/// - Parameter factory: The ``AsyncFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``AsyncFactory`` to resolve from.
+///   - batched: Let the enclosing ``ConstructorInjection()`` type store and resolve this property.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro ConstructorInjected<T>(_ factory: AsyncFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedAsyncMacro")
+public macro ConstructorInjected<T>(_ factory: AsyncFactory<T>, batched: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedAsyncMacro")
 
 /// Injects a dependency from an async throwing factory at init time. Wrapped value is `Task<T, any Error>`.
 /// The task is cancelled in `deinit`.
 ///
-/// - Parameter factory: The ``AsyncThrowingFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``AsyncThrowingFactory`` to resolve from.
+///   - batched: Let the enclosing ``ConstructorInjection()`` type store and resolve this property.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro ConstructorInjected<T>(_ factory: AsyncThrowingFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedAsyncThrowingMacro")
+public macro ConstructorInjected<T>(_ factory: AsyncThrowingFactory<T>, batched: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectedAsyncThrowingMacro")
+
+/// Resolves every `@ConstructorInjected(..., batched: true)` property of a type in one pass.
+///
+/// Each batched property is resolved through a single ``BoundResolver`` when the instance is
+/// created, instead of each property looking up ``Container/current`` on its own. Async
+/// properties still get their own task, so their resolvers run concurrently.
+///
+/// ```swift
+/// @ConstructorInjection
+/// final class CheckoutHandler {
+///     @ConstructorInjected(Container.cart, batched: true) var cart: Cart
+///     @ConstructorInjected(Container.pricing, batched: true) var pricing: Result<Pricing, any Error>
+///     @ConstructorInjected(Container.session, batched: true) var session: Task<Session, Never>
+/// }
+/// ```
+///
+/// Each property's factory type comes from the `@ConstructorInjected` overload its factory
+/// selects, so a sync factory that returns a `Result` or a type spelled `Swift.Task` resolves as
+/// it would unbatched.
+@attached(member, names: named(_ConstructorInjection), named(_constructorInjection))
+public macro ConstructorInjection() = #externalMacro(module: "DependencyInjectionMacros", type: "ConstructorInjectionMacro")
 
 // MARK: - @LazyInjected
 
@@ -137,16 +187,25 @@ public macro LazyInjected<T>(_ factory: SyncFactory<T>) = #externalMacro(module:
 public macro LazyInjected<T>(_ factory: SyncThrowingFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "LazyInjectedSyncThrowingMacro")
 
 /// Lazy injects from an async factory. Wrapped value is `Task<T, Never>`.
-/// The async task starts eagerly, but the result is cached on first read.
+/// By default the async task starts eagerly, but the result is cached on first read.
+///
+/// ```swift
+/// @LazyInjected(Container.session, startsOnFirstAccess: true) var session: Task<URLSession, Never>
+/// ```
 ///
-/// - Parameter factory: The ``AsyncFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``AsyncFactory`` to resolve from.
+///   - startsOnFirstAccess: Create the task on first read instead of at init, so building many
+///     instances doesn't spawn a task each. It still resolves in the container current at init.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro LazyInjected<T>(_ factory: AsyncFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "LazyInjectedAsyncMacro")
+public macro LazyInjected<T>(_ factory: AsyncFactory<T>, startsOnFirstAccess: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "LazyInjectedAsyncMacro")
 
 /// Lazy injects from an async throwing factory. Wrapped value is `Task<T, any Error>`.
 ///
-/// - Parameter factory: The ``AsyncThrowingFactory`` to resolve from.
+/// - Parameters:
+///   - factory: The ``AsyncThrowingFactory`` to resolve from.
+///   - startsOnFirstAccess: Create the task on first read instead of at init.
 @attached(accessor)
 @attached(peer, names: prefixed(_), prefixed(`$`))
-public macro LazyInjected<T>(_ factory: AsyncThrowingFactory<T>) = #externalMacro(module: "DependencyInjectionMacros", type: "LazyInjectedAsyncThrowingMacro")
+public macro LazyInjected<T>(_ factory: AsyncThrowingFactory<T>, startsOnFirstAccess: Bool = false) = #externalMacro(module: "DependencyInjectionMacros", type: "LazyInjectedAsyncThrowingMacro")
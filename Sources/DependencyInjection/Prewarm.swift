@@ -0,0 +1,176 @@
+//
+//  Prewarm.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Atomics
+
+/// A factory whose cache can be populated ahead of the first real resolution.
+///
+/// All four factory types conform. Prewarming only does work for factories with a
+/// ``CachedScope``; other scopes would discard the value (or, for ``SharedScope``, release it
+/// immediately), so they are skipped.
+public protocol Prewarmable: AnyObject, Sendable {
+    /// Resolves the factory in the current container so its cached value is ready.
+    ///
+    /// Errors thrown by a resolver are discarded; the next resolution simply retries.
+    func prewarm() async
+}
+
+extension SyncFactory: Prewarmable {
+    public func prewarm() async {
+        guard scope is CachedScope else { return }
+        _ = self()
+    }
+}
+
+extension SyncThrowingFactory: Prewarmable {
+    public func prewarm() async {
+        guard scope is CachedScope else { return }
+        _ = try? self()
+    }
+}
+
+extension AsyncFactory: Prewarmable {
+    public func prewarm() async {
+        guard scope is CachedScope else { return }
+        _ = await self()
+    }
+}
+
+extension AsyncThrowingFactory: Prewarmable {
+    public func prewarm() async {
+        guard scope is CachedScope else { return }
+        _ = try? await self()
+    }
+}
+
+extension Container {
+    /// Constructs the cached values of `factories` concurrently in the current container.
+    ///
+    /// Call this at launch so the first request doesn't pay for every singleton in its path:
+    ///
+    /// ```swift
+    /// await Container.prewarm([Container.database, Container.analytics, Container.imageCache])
+    /// ```
+    ///
+    /// Each factory is resolved in its own child task. A resolution that races the warm-up joins
+    /// the in-flight work instead of constructing a second instance: async cached factories share
+    /// the in-flight task, and sync ones wait for the pending resolution in the same container.
+    public static func prewarm(_ factories: [any Prewarmable]) async {
+        await withTaskGroup(of: Void.self) { group in
+            for factory in factories {
+                group.addTask { await factory.prewarm() }
+            }
+        }
+    }
+
+    /// Constructs `waves` one after another, resolving the factories of each wave concurrently.
+    ///
+    /// Pass the `Container.prewarmWaves` that `DependencyGraphPlugin` generates, where every
+    /// factory's construction dependencies are in an earlier wave. Each wave then only reads values
+    /// already cached, instead of its tasks waiting on each other's shared dependencies:
+    ///
+    /// ```swift
+    /// await Container.prewarm(waves: Container.prewarmWaves)
+    /// Container.default.freeze()
+    /// ```
+    public static func prewarm(waves: [[any Prewarmable]]) async {
+        for wave in waves {
+            await prewarm(wave)
+        }
+    }
+
+    /// Constructs the cached values of every live factory with a ``CachedScope`` concurrently
+    /// in the current container.
+    ///
+    /// - Important: This is not a launch-time warm-up. A factory is only known once it has been
+    ///   created, and `static let` factories are created lazily, on first access. At launch,
+    ///   before anything has touched them, there is nothing to warm, so this does (almost) no
+    ///   work. It only reaches factories that have already been accessed, for example to repopulate
+    ///   caches after `cache.clear()`. To warm at launch, name the factories, preferably with the
+    ///   `Container.prewarmWaves` that `DependencyGraphPlugin` generates:
+    ///
+    ///   ```swift
+    ///   await Container.prewarm(waves: Container.prewarmWaves)
+    ///   ```
+    public static func prewarmCachedFactories() async {
+        await prewarm(CachedFactories.all())
+    }
+}
+
+/// Every factory created with a ``CachedScope``, for ``Container/prewarmCachedFactories()``.
+///
+/// Factories record themselves in their initializer, so a `static let` factory that hasn't been
+/// accessed yet isn't in the list.
+///
+/// A lock-free, push-only list so recording a factory at creation never contends. Nodes hold
+/// their factory weakly, so short-lived factories are skipped once they are released, and the
+/// list is pruned of them every time it is read and whenever enough pushes have piled up.
+enum CachedFactories {
+    private final class Node: AtomicReference, @unchecked Sendable {
+        weak var factory: (any Prewarmable)?
+        let next: Node?
+
+        init(factory: any Prewarmable, next: Node?) {
+            self.factory = factory
+            self.next = next
+        }
+    }
+
+    private static let head = ManagedAtomic<Node?>(nil)
+    // Pushes since the list was last pruned, and how many nodes that prune kept. Pruning once the
+    // pushes outnumber the kept nodes keeps its cost amortized constant per push.
+    private static let pushesSincePrune = ManagedAtomic(0)
+    private static let keptByLastPrune = ManagedAtomic(0)
+
+    static func record(_ factory: some _Factory & Prewarmable) {
+        guard factory.scope is CachedScope else { return }
+        var current = head.load(ordering: .relaxed)
+        while true {
+            let (exchanged, original) = head.compareExchange(expected: current,
+                                                             desired: Node(factory: factory, next: current),
+                                                             ordering: .releasing)
+            if exchanged { break }
+            current = original
+        }
+        let pushes = pushesSincePrune.wrappingIncrementThenLoad(ordering: .relaxed)
+        // One push per threshold prunes, so a prune that lost a race is retried a threshold later.
+        if pushes % max(64, keptByLastPrune.load(ordering: .relaxed)) == 0 {
+            prune()
+        }
+    }
+
+    static func all() -> [any Prewarmable] {
+        prune()
+    }
+
+    /// Replaces the list with one holding only live factories and returns them.
+    ///
+    /// If a push races the rebuild, the rebuilt list is discarded and the old one, dead nodes
+    /// included, stays until the next prune. The loaded head is retained throughout, so the
+    /// exchange can't be fooled by a node being freed and its address reused.
+    @discardableResult
+    private static func prune() -> [any Prewarmable] {
+        let current = head.load(ordering: .acquiring)
+        var factories = [any Prewarmable]()
+        var node = current
+        while let next = node {
+            if let factory = next.factory {
+                factories.append(factory)
+            }
+            node = next.next
+        }
+        var rebuilt: Node?
+        for factory in factories.reversed() {
+            rebuilt = Node(factory: factory, next: rebuilt)
+        }
+        if head.compareExchange(expected: current, desired: rebuilt, ordering: .acquiringAndReleasing).exchanged {
+            pushesSincePrune.store(0, ordering: .relaxed)
+            keptByLastPrune.store(factories.count, ordering: .relaxed)
+        }
+        return factories
+    }
+}
@@ -4,148 +4,29 @@
 //
 //  Created by Tyler Thompson on 8/1/24.
 //
-import Foundation
 
-final class SyncRegistrations<Dependency>: @unchecked Sendable {
-    private let lock = NSRecursiveLock()
-
-    private var resolvers = [() -> Dependency]()
-    
-    func add(resolver: @escaping () -> Dependency) {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.append(resolver)
-    }
-    
-    func currentResolver() -> (() -> Dependency)? {
-        lock.lock()
-        defer { lock.unlock() }
-        return resolvers.last
-    }
-    
-    func clear() {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
-    }
-    
-    func pop() {
-        lock.lock()
-        defer { lock.unlock() }
-        _ = resolvers.popLast()
-    }
-    
-    deinit {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
-    }
-}
-
-final class SyncThrowingRegistrations<Dependency>: @unchecked Sendable {
-    private let lock = NSRecursiveLock()
-    
-    private var resolvers = [() throws -> Dependency]()
-    
-    func add(resolver: @escaping () throws -> Dependency) {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.append(resolver)
-    }
-    
-    func currentResolver() -> (() throws -> Dependency)? {
-        lock.lock()
-        defer { lock.unlock() }
-        return resolvers.last
-    }
-    
-    func clear() {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
-    }
+// Registration stacks are plain values. They are only ever mutated on a private copy of a
+// `Container.Storage` while the container's write lock is held, then published as part of an
+// immutable `Container.Registry` snapshot, so reading `currentResolver` never needs a lock.
+//
+// A stack is specialized to its factory's resolver type, so each factory kind gets exactly one.
 
-    func pop() {
-        lock.lock()
-        defer { lock.unlock() }
-        _ = resolvers.popLast()
-    }
-    
-    deinit {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
-    }
-}
+struct Registrations<Resolver> {
+    private var resolvers = [Resolver]()
 
-final class AsyncRegistrations<Dependency>: @unchecked Sendable {
-    private let lock = NSRecursiveLock()
-    
-    private var resolvers = [@Sendable () async -> Dependency]()
-    
-    func add(resolver: @Sendable @escaping () async -> Dependency) {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.append(resolver)
-    }
-    
-    func currentResolver() -> (@Sendable () async -> Dependency)? {
-        lock.lock()
-        defer { lock.unlock() }
-        return resolvers.last
-    }
-    
-    func clear() {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
+    var currentResolver: Resolver? {
+        resolvers.last
     }
 
-    func pop() {
-        lock.lock()
-        defer { lock.unlock() }
-        _ = resolvers.popLast()
+    var isEmpty: Bool {
+        resolvers.isEmpty
     }
-    
-    deinit {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
-    }
-}
 
-final class AsyncThrowingRegistrations<Dependency>: @unchecked Sendable {
-    private let lock = NSRecursiveLock()
-    
-    private var resolvers = [@Sendable () async throws -> Dependency]()
-    
-    func add(resolver: @Sendable @escaping () async throws -> Dependency) {
-        lock.lock()
-        defer { lock.unlock() }
+    mutating func add(resolver: Resolver) {
         resolvers.append(resolver)
     }
-    
-    func currentResolver() -> (@Sendable () async throws -> Dependency)? {
-        lock.lock()
-        defer { lock.unlock() }
-        return resolvers.last
-    }
-    
-    func clear() {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
-    }
 
-    func pop() {
-        lock.lock()
-        defer { lock.unlock() }
+    mutating func pop() {
         _ = resolvers.popLast()
     }
-    
-    deinit {
-        lock.lock()
-        defer { lock.unlock() }
-        resolvers.removeAll()
-    }
 }
@@ -0,0 +1,260 @@
+//
+//  RequestScope.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+import ServiceContextModule
+
+extension Scope {
+    /// A scope that creates the instance once per request and releases it when the request ends.
+    ///
+    /// Requests are delimited with ``withRequestScope(operation:)``. Outside a request the
+    /// factory behaves like ``unique``.
+    public static var request: RequestScope { RequestScope() }
+}
+
+/// A scope that caches the resolved instance for the duration of a request.
+///
+/// Every request-scoped instance of a request lives in a single store owned by the enclosing
+/// ``withRequestScope(operation:)`` call, and all of them are released together when it
+/// returns. Nothing outlives the request, so there is no per-container cache to grow or evict.
+///
+/// ```swift
+/// extension Container {
+///     static let unitOfWork = Factory(scope: .request) { UnitOfWork() }
+/// }
+///
+/// func handle(_ request: HTTPRequest) async throws -> HTTPResponse {
+///     try await withRequestScope {
+///         // Every resolution of Container.unitOfWork in here returns the same instance.
+///     }
+/// }
+/// ```
+///
+/// Within a request, instances are cached per container like ``CachedScope``, and concurrent
+/// async resolutions are deduplicated. Resolutions outside a request create a new instance
+/// every time.
+public final class RequestScope: Scope, ScopeWithCache, @unchecked Sendable {
+    /// Clears this scope's instance in the current request.
+    public var cache: any Cache { RequestCache(scopeID: ObjectIdentifier(self)) }
+
+    override func resolve<D>(resolver: @escaping SyncFactory<D>.Resolver) -> D {
+        guard let store = RequestStore.current else { return resolver() }
+        return store.resolve(for: ObjectIdentifier(self), resolver: resolver)
+    }
+
+    override func resolve<D>(resolver: @escaping SyncThrowingFactory<D>.Resolver) throws -> D {
+        guard let store = RequestStore.current else { return try resolver() }
+        return try store.resolve(for: ObjectIdentifier(self), resolver: resolver)
+    }
+
+    override func resolve<D>(resolver: @escaping AsyncFactory<D>.Resolver) async -> D {
+        guard let store = RequestStore.current else { return await resolver() }
+        return await store.resolve(for: ObjectIdentifier(self), resolver: resolver)
+    }
+
+    override func resolve<D>(resolver: @escaping AsyncThrowingFactory<D>.Resolver) async throws -> D {
+        guard let store = RequestStore.current else { return try await resolver() }
+        return try await store.resolve(for: ObjectIdentifier(self), resolver: resolver)
+    }
+}
+
+/// Runs a synchronous operation as a request, releasing its request-scoped instances when it returns.
+///
+/// Requests nest: an inner call starts a fresh request whose instances are released when it returns.
+///
+/// - Parameter operation: The operation to execute as a request.
+/// - Returns: The result of the operation.
+/// - Throws: Any error thrown by the operation.
+public func withRequestScope<T>(operation: () throws -> T) rethrows -> T {
+    let store = RequestStore()
+    defer { store.end() }
+    var context = ServiceContext.inUse
+    context.requestStore = store
+    return try ServiceContext.withValue(context, operation: operation)
+}
+
+/// Runs an asynchronous operation as a request, releasing its request-scoped instances when it returns.
+///
+/// - Parameters:
+///   - isolation: The actor isolation context.
+///   - operation: The async operation to execute as a request.
+/// - Returns: The result of the operation.
+/// - Throws: Any error thrown by the operation.
+public func withRequestScope<T>(isolation: isolated(any Actor)? = #isolation, operation: () async throws -> T) async rethrows -> T {
+    let store = RequestStore()
+    defer { store.end() }
+    var context = ServiceContext.inUse
+    context.requestStore = store
+    return try await ServiceContext.withValue(context, operation: operation)
+}
+
+/// The instances of every ``RequestScope`` for one request.
+///
+/// Requests hold a handful of instances, so they are kept in one contiguous buffer and found
+/// with a linear scan rather than a hash map per scope.
+final class RequestStore: @unchecked Sendable {
+    private enum Slot {
+        case resolved(Any)
+        case inFlight(Any)
+    }
+
+    private struct Entry {
+        let scopeID: ObjectIdentifier
+        // Held strongly so the identity can't be recycled while the request is alive.
+        let container: Container
+        var slot: Slot
+    }
+
+    private let lock = TrackedLock(site: "RequestStore")
+    private var entries = ContiguousArray<Entry>()
+    // Synchronous resolutions in progress, per scope.
+    private var syncResolutions = [ObjectIdentifier: SyncResolutions]()
+    private var ended = false
+
+    static var current: RequestStore? {
+        ServiceContext.current?.requestStore
+    }
+
+    /// Releases every instance at once. Resolutions that finish afterwards are not stored.
+    func end() {
+        var released = ContiguousArray<Entry>()
+        lock.protect {
+            ended = true
+            swap(&released, &entries)
+        }
+        // `released` goes out of scope here, so the instances deinitialize outside the lock.
+    }
+
+    func clear(scopeID: ObjectIdentifier, in container: Container) {
+        lock.protect {
+            entries.removeAll { $0.scopeID == scopeID && $0.container === container }
+        }
+    }
+
+    func resolve<D>(for scopeID: ObjectIdentifier, resolver: () throws -> D) rethrows -> D {
+        let container = Container.current
+        if let result = lock.protect({ resolvedValue(for: scopeID, in: container, as: D.self) }) {
+            return result
+        }
+        // The resolver runs unlocked, as in `CachedScope`: only callers resolving the same scope in
+        // the same container wait for it.
+        let resolutions: SyncResolutions = lock.protect {
+            if let resolutions = syncResolutions[scopeID] { return resolutions }
+            let resolutions = SyncResolutions()
+            syncResolutions[scopeID] = resolutions
+            return resolutions
+        }
+        return try resolutions.resolve(cached: { lock.protect { resolvedValue(for: scopeID, in: container, as: D.self) } },
+                                       store: { resolved in lock.protect { store(.resolved(resolved), for: scopeID, in: container) } },
+                                       resolver: resolver)
+    }
+
+    func resolve<D: Sendable>(for scopeID: ObjectIdentifier, resolver: @escaping @Sendable () async -> D) async -> D {
+        let resolution: AsyncResolution<D, Never> = lock.protect {
+            let container = Container.current
+            if let index = index(of: scopeID, in: container) {
+                switch entries[index].slot {
+                case .resolved(let value):
+                    if let result = value as? D { return .cached(result) }
+                case .inFlight(let task):
+                    if let task = task as? Task<D, Never> { return .inFlight(task) }
+                }
+            }
+            let task = Task {
+                let resolved = await resolver()
+                self.finish(scopeID, in: container, with: resolved)
+                return resolved
+            }
+            store(.inFlight(task), for: scopeID, in: container)
+            return .inFlight(task)
+        }
+        switch resolution {
+        case .cached(let result): return result
+        case .inFlight(let task): return await task.value
+        }
+    }
+
+    func resolve<D: Sendable>(for scopeID: ObjectIdentifier, resolver: @escaping @Sendable () async throws -> D) async throws -> D {
+        let resolution: AsyncResolution<D, any Error> = lock.protect {
+            let container = Container.current
+            if let index = index(of: scopeID, in: container) {
+                switch entries[index].slot {
+                case .resolved(let value):
+                    if let result = value as? D { return .cached(result) }
+                case .inFlight(let task):
+                    if let task = task as? Task<D, any Error> { return .inFlight(task) }
+                }
+            }
+            let task = Task {
+                do {
+                    let resolved = try await resolver()
+                    self.finish(scopeID, in: container, with: resolved)
+                    return resolved
+                } catch {
+                    self.clear(scopeID: scopeID, in: container)
+                    throw error
+                }
+            }
+            store(.inFlight(task), for: scopeID, in: container)
+            return .inFlight(task)
+        }
+        switch resolution {
+        case .cached(let result): return result
+        case .inFlight(let task): return try await task.value
+        }
+    }
+
+    private func finish(_ scopeID: ObjectIdentifier, in container: Container, with resolved: Any) {
+        lock.protect {
+            // The entry may have been cleared (re-registration) while the task ran.
+            guard index(of: scopeID, in: container) != nil else { return }
+            store(.resolved(resolved), for: scopeID, in: container)
+        }
+    }
+
+    private func resolvedValue<D>(for scopeID: ObjectIdentifier, in container: Container, as type: D.Type) -> D? {
+        guard let index = index(of: scopeID, in: container),
+              case .resolved(let value) = entries[index].slot else { return nil }
+        return value as? D
+    }
+
+    private func index(of scopeID: ObjectIdentifier, in container: Container) -> Int? {
+        entries.firstIndex { $0.scopeID == scopeID && $0.container === container }
+    }
+
+    private func store(_ slot: Slot, for scopeID: ObjectIdentifier, in container: Container) {
+        guard !ended else { return }
+        if let index = index(of: scopeID, in: container) {
+            entries[index].slot = slot
+        } else {
+            entries.append(Entry(scopeID: scopeID, container: container, slot: slot))
+        }
+    }
+}
+
+/// The ``Cache`` of a ``RequestScope``: clearing it drops the scope's instance in the current request.
+struct RequestCache: Cache {
+    let scopeID: ObjectIdentifier
+
+    func clear() {
+        RequestStore.current?.clear(scopeID: scopeID, in: Container.current)
+    }
+}
+
+struct ServiceContextRequestStoreKey: ServiceContextKey {
+    typealias Value = RequestStore
+}
+
+extension ServiceContext {
+    var requestStore: RequestStore? {
+        get {
+            self[ServiceContextRequestStoreKey.self]
+        } set {
+            self[ServiceContextRequestStoreKey.self] = newValue
+        }
+    }
+}
@@ -0,0 +1,113 @@
+//
+//  ResolutionTable.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Atomics
+
+extension Container {
+    /// The read-only resolution table of a frozen container, built by ``Container/freeze()``.
+    ///
+    /// There is a slot for every factory that existed when the container was frozen, holding its
+    /// registered storage (if any) and, for inlinable scopes, the value once it has been built.
+    /// Factories created after freezing have no slot and resolve the ordinary way.
+    ///
+    /// The inlined values live in one buffer of atomic references, so freezing allocates once
+    /// however many slots have been handed out, and a slot costs a pointer until it is used.
+    final class ResolutionTable: @unchecked Sendable {
+        fileprivate let registry: Registry
+        private let count: Int
+        fileprivate let inlined: UnsafeMutablePointer<UnsafeAtomic<InlinedValue?>.Storage>
+
+        /// Builds the table for `registry`, which must not be frozen itself.
+        init(registry: Registry) {
+            self.registry = registry
+            count = factorySlotCount()
+            inlined = .allocate(capacity: count)
+            inlined.initialize(repeating: .init(nil), count: count)
+        }
+
+        deinit {
+            for slot in 0..<count {
+                _ = (inlined + slot).move().dispose()
+            }
+            inlined.deallocate()
+        }
+
+        subscript(slot: Int) -> Slot? {
+            slot < count ? Slot(table: self, index: slot) : nil
+        }
+    }
+}
+
+extension Container.ResolutionTable {
+    /// A view of one slot of the table. It retains the table, so the atomic it reads stays valid
+    /// even if the container thaws and drops the table meanwhile.
+    struct Slot {
+        private let table: Container.ResolutionTable
+        private let index: Int
+
+        fileprivate init(table: Container.ResolutionTable, index: Int) {
+            self.table = table
+            self.index = index
+        }
+
+        private var inlined: UnsafeAtomic<InlinedValue?> {
+            UnsafeAtomic(at: table.inlined + index)
+        }
+
+        /// The frozen container's registered resolver, or `nil` to use the factory's own.
+        func resolver<F: _Factory>(for factory: F) -> F.Resolver? {
+            table.registry.storage(for: factory)?.registrations.currentResolver
+        }
+
+        /// The cache backing `factory` if its values may be inlined: its scope caches strongly and never evicts.
+        func inliningCache<F: _Factory>(for factory: F) -> StrongCache? {
+            guard let scope = factory.scope as? CachedScope, !scope.evicts else { return nil }
+            return scope.strongCache
+        }
+
+        /// The inlined value, unless there is none, the cache has dropped or replaced an entry since
+        /// it was built, or an observer needs to see the resolution.
+        func inlinedValue<D>(as type: D.Type) -> D? {
+            guard let inlined = self.inlined.load(ordering: .acquiring),
+                  inlined.version == inlined.cache.version.load(ordering: .acquiring),
+                  !ResolutionInstrumentation.isObserving else {
+                return nil
+            }
+            // A slot belongs to a single factory, so the value is always of its dependency type.
+            return unsafeDowncast(inlined, to: TypedInlinedValue<D>.self).value
+        }
+
+        /// Inlines `value`, built while `cache` was at `version`.
+        func inline<D>(_ value: D, from cache: StrongCache, version: Int) {
+            self.inlined.store(TypedInlinedValue(value, cache: cache, version: version), ordering: .releasing)
+        }
+    }
+
+    /// An inlined value, stamped with the version of the cache it was stored in.
+    ///
+    /// Registration changes replace the whole table, so the cache's version is the only thing an
+    /// inlined value can outlive. It is the cache's own counter, so overrides and clears in other
+    /// caches (or per-request nested containers registering overrides) leave the value in place.
+    class InlinedValue: AtomicReference, @unchecked Sendable {
+        let cache: StrongCache
+        let version: Int
+
+        init(cache: StrongCache, version: Int) {
+            self.cache = cache
+            self.version = version
+        }
+    }
+
+    final class TypedInlinedValue<D>: InlinedValue, @unchecked Sendable {
+        let value: D
+
+        init(_ value: D, cache: StrongCache, version: Int) {
+            self.value = value
+            super.init(cache: cache, version: version)
+        }
+    }
+}
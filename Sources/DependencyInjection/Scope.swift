@@ -7,15 +7,6 @@
 
 import Foundation
 
-/// A global actor used to serialize async resolution for cached and shared scopes.
-///
-/// This prevents duplicate async tasks from running concurrently when multiple
-/// callers resolve the same cached/shared factory at the same time.
-@globalActor
-actor DIActor: GlobalActor {
-    static let shared = DIActor()
-}
-
 protocol ScopeWithCache {
     var cache: any Cache { get }
 }
@@ -73,6 +64,28 @@ extension Scope {
     /// runs the resolver and all callers await the same result.
     public static var cached: CachedScope { CachedScope() }
 
+    /// A scope that caches the instance with a strong reference for `ttl` after it is created.
+    ///
+    /// The next resolution after the instance expires creates a new one. Expired instances are
+    /// released the next time the scope stores a value.
+    public static func cached(ttl: Duration) -> CachedScope {
+        CachedScope(policy: EvictionPolicy(ttl: ttl))
+    }
+
+    /// A scope that caches the instance with a strong reference in at most `capacity` containers.
+    ///
+    /// When another container stores a value past the limit, the least recently used containers'
+    /// instances are released (approximately, with a CLOCK sweep). Use it for expensive
+    /// per-tenant dependencies where each tenant gets its own container.
+    public static func cached(capacity: Int) -> CachedScope {
+        CachedScope(policy: EvictionPolicy(capacity: capacity))
+    }
+
+    /// A scope that caches the instance for `ttl` in at most `capacity` containers.
+    public static func cached(ttl: Duration, capacity: Int) -> CachedScope {
+        CachedScope(policy: EvictionPolicy(ttl: ttl, capacity: capacity))
+    }
+
     /// A scope that creates the instance once and caches it with a weak reference.
     ///
     /// The instance is kept alive as long as at least one external reference exists.
@@ -93,78 +106,110 @@ public final class UniqueScope: Scope, @unchecked Sendable { }
 /// within the same container. The cache is per-container, so test containers
 /// get their own isolated cache entries.
 ///
-/// For async factories, resolution is serialized via ``DIActor`` and concurrent
-/// callers are deduplicated -- only one task runs the resolver.
+/// For async factories, concurrent callers in the same container are deduplicated --
+/// only one task runs the resolver and the others await it. Unrelated factories and
+/// containers never wait on each other, and a cache hit returns without suspending.
 public final class CachedScope: Scope, ScopeWithCache, @unchecked Sendable {
-    private let lock = NSRecursiveLock()
+    private let lock = TrackedLock(site: "CachedScope")
+    let strongCache: StrongCache
     /// The strong cache backing this scope.
-    public let cache: any Cache = StrongCache()
+    public var cache: any Cache { strongCache }
     private var taskStorage = [ObjectIdentifier: Any]()
+    private let syncResolutions = SyncResolutions()
+
+    /// Whether cached instances can expire or be evicted by ``Scope/cached(ttl:)`` or ``Scope/cached(capacity:)`` limits.
+    var evicts: Bool { strongCache.policy.evicts }
+
+    init(policy: EvictionPolicy = .none) {
+        strongCache = StrongCache(policy: policy)
+    }
 
     override func resolve<D>(resolver: @escaping SyncFactory<D>.Resolver) -> D {
-        lock.protect {
-            if cache.hasValue, let result = cache() as? D {
-                return result
-            }
-            let resolved = resolver()
-            cache.register(resolved)
-            return resolved
+        if let result = strongCache.cachedValueForCurrentContainer(as: D.self) {
+            return result
         }
+        return syncResolutions.resolve(cached: { strongCache.cachedValue(as: D.self) },
+                                          store: { strongCache.register($0) },
+                                          resolver: resolver)
     }
 
     override func resolve<D>(resolver: @escaping SyncThrowingFactory<D>.Resolver) throws -> D {
-        try lock.protect {
-            if cache.hasValue, let result = cache() as? D {
-                return result
-            }
-            let resolved = try resolver()
-            cache.register(resolved)
-            return resolved
+        if let result = strongCache.cachedValueForCurrentContainer(as: D.self) {
+            return result
         }
+        return try syncResolutions.resolve(cached: { strongCache.cachedValue(as: D.self) },
+                                          store: { strongCache.register($0) },
+                                          resolver: resolver)
     }
 
-    @DIActor override func resolve<D>(resolver: @escaping AsyncFactory<D>.Resolver) async -> D {
-        if cache.hasValue, let result = cache() as? D {
+    override func resolve<D>(resolver: @escaping AsyncFactory<D>.Resolver) async -> D {
+        if let result = strongCache.cachedValueForCurrentContainer(as: D.self) {
             return result
         }
-        let containerId = ObjectIdentifier(Container.current)
-        if let task = lock.protect({ self.taskStorage[containerId] }) as? Task<D, Never> {
-            return await task.value
-        }
-        defer { lock.protect { self.taskStorage[containerId] = nil } }
-        let task = Task { [weak self] in
-            let resolved = await resolver()
-            if let self {
-                self.lock.protect {
-                    self.cache.register(resolved)
-                }
+        let resolution: AsyncResolution<D, Never> = lock.protect {
+            if let result = strongCache.cachedValue(as: D.self) {
+                return .cached(result)
+            }
+            let containerId = ObjectIdentifier(Container.current)
+            if let task = taskStorage[containerId] as? Task<D, Never> {
+                return .inFlight(task)
             }
-            return resolved
+            let task = Task { [weak self] in
+                let resolved = await resolver()
+                self?.finishTask(for: containerId, caching: resolved)
+                return resolved
+            }
+            taskStorage[containerId] = task
+            return .inFlight(task)
+        }
+        switch resolution {
+        case .cached(let result): return result
+        case .inFlight(let task): return await task.value
         }
-        lock.protect { self.taskStorage[containerId] = task }
-        return await task.value
     }
 
-    @DIActor override func resolve<D>(resolver: @escaping AsyncThrowingFactory<D>.Resolver) async throws -> D {
-        if cache.hasValue, let result = cache() as? D {
+    override func resolve<D>(resolver: @escaping AsyncThrowingFactory<D>.Resolver) async throws -> D {
+        if let result = strongCache.cachedValueForCurrentContainer(as: D.self) {
             return result
         }
-        let containerId = ObjectIdentifier(Container.current)
-        if let task = lock.protect({ self.taskStorage[containerId] }) as? Task<D, any Error> {
-            return try await task.value
-        }
-        defer { lock.protect { self.taskStorage[containerId] = nil } }
-        let task = Task { [weak self] in
-            let resolved = try await resolver()
-            if let self {
-                self.lock.protect {
-                    self.cache.register(resolved)
+        let resolution: AsyncResolution<D, any Error> = lock.protect {
+            if let result = strongCache.cachedValue(as: D.self) {
+                return .cached(result)
+            }
+            let containerId = ObjectIdentifier(Container.current)
+            if let task = taskStorage[containerId] as? Task<D, any Error> {
+                return .inFlight(task)
+            }
+            let task = Task { [weak self] in
+                do {
+                    let resolved = try await resolver()
+                    self?.finishTask(for: containerId, caching: resolved)
+                    return resolved
+                } catch {
+                    self?.finishTask(for: containerId)
+                    throw error
                 }
             }
-            return resolved
+            taskStorage[containerId] = task
+            return .inFlight(task)
+        }
+        switch resolution {
+        case .cached(let result): return result
+        case .inFlight(let task): return try await task.value
+        }
+    }
+
+    private func finishTask<D>(for containerId: ObjectIdentifier, caching resolved: D) {
+        lock.protect {
+            strongCache.register(resolved)
+            taskStorage[containerId] = nil
+        }
+    }
+
+    private func finishTask(for containerId: ObjectIdentifier) {
+        lock.protect {
+            taskStorage[containerId] = nil
         }
-        lock.protect { self.taskStorage[containerId] = task }
-        return try await task.value
     }
 }
 
@@ -176,75 +221,180 @@ public final class CachedScope: Scope, ScopeWithCache, @unchecked Sendable {
 ///
 /// This is useful for shared resources that should be deallocated when no longer in use.
 public final class SharedScope: Scope, ScopeWithCache, @unchecked Sendable {
-    private let lock = NSRecursiveLock()
+    private let lock = TrackedLock(site: "SharedScope")
+    private let weakCache = WeakCache()
     /// The weak cache backing this scope.
-    public let cache: any Cache = WeakCache()
+    public var cache: any Cache { weakCache }
     private var taskStorage = [ObjectIdentifier: Any]()
+    private let syncResolutions = SyncResolutions()
 
     override func resolve<D>(resolver: @escaping SyncFactory<D>.Resolver) -> D {
-        lock.protect {
-            if cache.hasValue, let result = cache() as? D {
-                return result
-            }
-            let resolved = resolver()
-            cache.register(resolved)
-            return resolved
-        }
+        syncResolutions.resolve(cached: { weakCache.cachedValue(as: D.self) },
+                                   store: { weakCache.register($0) },
+                                   resolver: resolver)
     }
 
     override func resolve<D>(resolver: @escaping SyncThrowingFactory<D>.Resolver) throws -> D {
-        try lock.protect {
-            if let result = cache() as? D {
-                return result
-            }
-            let resolved = try resolver()
-            cache.register(resolved)
-            return resolved
-        }
+        try syncResolutions.resolve(cached: { weakCache.cachedValue(as: D.self) },
+                                   store: { weakCache.register($0) },
+                                   resolver: resolver)
     }
 
-    @DIActor override func resolve<D>(resolver: @escaping AsyncFactory<D>.Resolver) async -> D {
-        if cache.hasValue, let result = cache() as? D {
-            return result
+    override func resolve<D>(resolver: @escaping AsyncFactory<D>.Resolver) async -> D {
+        let resolution: AsyncResolution<D, Never> = lock.protect {
+            if let result = weakCache.cachedValue(as: D.self) {
+                return .cached(result)
+            }
+            let containerId = ObjectIdentifier(Container.current)
+            if let task = taskStorage[containerId] as? Task<D, Never> {
+                return .inFlight(task)
+            }
+            let task = Task { [weak self] in
+                let resolved = await resolver()
+                self?.finishTask(for: containerId, caching: resolved)
+                return resolved
+            }
+            taskStorage[containerId] = task
+            return .inFlight(task)
         }
-        let containerId = ObjectIdentifier(Container.current)
-        if let task = lock.protect({ self.taskStorage[containerId] }) as? Task<D, Never> {
-            return await task.value
+        switch resolution {
+        case .cached(let result): return result
+        case .inFlight(let task): return await task.value
         }
-        defer { lock.protect { self.taskStorage[containerId] = nil } }
-        let task = Task { [weak self] in
-            let resolved = await resolver()
-            if let self {
-                self.lock.protect {
-                    self.cache.register(resolved)
+    }
+
+    override func resolve<D>(resolver: @escaping AsyncThrowingFactory<D>.Resolver) async throws -> D {
+        let resolution: AsyncResolution<D, any Error> = lock.protect {
+            if let result = weakCache.cachedValue(as: D.self) {
+                return .cached(result)
+            }
+            let containerId = ObjectIdentifier(Container.current)
+            if let task = taskStorage[containerId] as? Task<D, any Error> {
+                return .inFlight(task)
+            }
+            let task = Task { [weak self] in
+                do {
+                    let resolved = try await resolver()
+                    self?.finishTask(for: containerId, caching: resolved)
+                    return resolved
+                } catch {
+                    self?.finishTask(for: containerId)
+                    throw error
                 }
             }
-            return resolved
+            taskStorage[containerId] = task
+            return .inFlight(task)
+        }
+        switch resolution {
+        case .cached(let result): return result
+        case .inFlight(let task): return try await task.value
         }
-        lock.protect { self.taskStorage[containerId] = task }
-        return await task.value
     }
 
-    @DIActor override func resolve<D>(resolver: @escaping AsyncThrowingFactory<D>.Resolver) async throws -> D {
-        if cache.hasValue, let result = cache() as? D {
-            return result
+    private func finishTask<D>(for containerId: ObjectIdentifier, caching resolved: D) {
+        lock.protect {
+            weakCache.register(resolved)
+            taskStorage[containerId] = nil
         }
-        let containerId = ObjectIdentifier(Container.current)
-        if let task = lock.protect({ self.taskStorage[containerId] }) as? Task<D, any Error> {
-            return try await task.value
+    }
+
+    private func finishTask(for containerId: ObjectIdentifier) {
+        lock.protect {
+            taskStorage[containerId] = nil
         }
-        defer { lock.protect { self.taskStorage[containerId] = nil } }
-        let task = Task { [weak self] in
-            let resolved = try await resolver()
-            if let self {
-                self.lock.protect {
-                    self.cache.register(resolved)
+    }
+}
+
+/// The outcome of looking up an async cached/shared resolution under the scope lock.
+enum AsyncResolution<D: Sendable, Failure: Error> {
+    case cached(D)
+    case inFlight(Task<D, Failure>)
+}
+
+/// Runs a caching scope's synchronous resolutions at most once per container at a time.
+///
+/// Only the bookkeeping happens under the lock; the resolver always runs outside it. Callers
+/// resolving in a container that is already resolving wait for that result, callers in other
+/// containers never wait, and a resolver that re-enters its own factory on the same thread runs
+/// uncached instead of deadlocking on itself.
+final class SyncResolutions: @unchecked Sendable {
+    private let lock = TrackedLock(site: "SyncResolutions")
+    private var pending = [ObjectIdentifier: PendingResolution]()
+
+    func resolve<D>(cached: () -> D?, store: (D) -> Void, resolver: () throws -> D) rethrows -> D {
+        let containerId = ObjectIdentifier(Container.current)
+        while true {
+            let claim: SyncClaim<D> = lock.protect {
+                if let resolution = pending[containerId] {
+                    return resolution.isOwnedByCurrentThread ? .reentrant : .waiting(resolution)
+                }
+                // Checked under the lock: a finished resolution is stored before it stops being pending.
+                if let result = cached() {
+                    return .cached(result)
                 }
+                let resolution = PendingResolution()
+                pending[containerId] = resolution
+                return .resolving(resolution)
+            }
+            switch claim {
+            case .cached(let result):
+                return result
+            case .reentrant:
+                return try resolver()
+            case .waiting(let resolution):
+                if let value = resolution.wait(), let result = value as? D {
+                    return result
+                }
+                // The resolver threw; go around again, possibly resolving ourselves.
+            case .resolving(let resolution):
+                var resolved: D?
+                defer {
+                    lock.protect { pending[containerId] = nil }
+                    resolution.finish(with: resolved.map { $0 as Any })
+                }
+                let result = try resolver()
+                store(result)
+                resolved = result
+                return result
             }
-            return resolved
         }
-        lock.protect { self.taskStorage[containerId] = task }
-        return try await task.value
+    }
+}
+
+private enum SyncClaim<D> {
+    case cached(D)
+    case resolving(PendingResolution)
+    case waiting(PendingResolution)
+    case reentrant
+}
+
+/// A synchronous resolution in progress, which other threads resolving in the same container wait on.
+final class PendingResolution: @unchecked Sendable {
+    private let owner = pthread_self()
+    private let condition = NSCondition()
+    private var finished = false
+    private var value: Any?
+
+    var isOwnedByCurrentThread: Bool {
+        pthread_equal(owner, pthread_self()) != 0
+    }
+
+    /// Wakes every waiter with the resolved value, or `nil` if the resolver threw.
+    func finish(with value: Any?) {
+        condition.lock()
+        defer { condition.unlock() }
+        self.value = value
+        finished = true
+        condition.broadcast()
+    }
+
+    func wait() -> Any? {
+        condition.lock()
+        defer { condition.unlock() }
+        while !finished {
+            condition.wait()
+        }
+        return value
     }
 }
 
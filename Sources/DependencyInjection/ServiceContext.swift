@@ -58,6 +58,8 @@ extension ServiceContext {
 ///
 /// The child container inherits all registrations from its parent but can override
 /// them independently. When the operation completes, the child container is discarded.
+/// Child containers nothing else holds on to are recycled for later calls, so nesting per
+/// request or per job doesn't allocate a container each time.
 ///
 /// ```swift
 /// Container.logger.register { ConsoleLogger() }
@@ -74,9 +76,14 @@ extension ServiceContext {
 /// - Returns: The result of the operation.
 /// - Throws: Any error thrown by the operation.
 public func withNestedContainer<T>(operation: () throws -> T) rethrows -> T {
-    var context = ServiceContext.inUse
-    context.container = Container(parent: Container.current)
-    return try ServiceContext.withValue(context, operation: operation)
+    var child = ContainerPool.shared.take(parent: Container.current)
+    defer { ContainerPool.shared.recycle(&child) }
+    // The context goes out of scope before the deferred recycle, so it doesn't count as a reference.
+    do {
+        var context = ServiceContext.inUse
+        context.container = child
+        return try ServiceContext.withValue(context, operation: operation)
+    }
 }
 
 /// Creates a child container and executes an asynchronous operation within it.
@@ -90,7 +97,11 @@ public func withNestedContainer<T>(operation: () throws -> T) rethrows -> T {
 /// - Returns: The result of the operation.
 /// - Throws: Any error thrown by the operation.
 public func withNestedContainer<T>(isolation: isolated(any Actor)? = #isolation, operation: () async throws -> T) async rethrows -> T {
-    var context = ServiceContext.inUse
-    context.container = Container(parent: Container.current)
-    return try await ServiceContext.withValue(context, operation: operation)
+    var child = ContainerPool.shared.take(parent: Container.current)
+    defer { ContainerPool.shared.recycle(&child) }
+    do {
+        var context = ServiceContext.inUse
+        context.container = child
+        return try await ServiceContext.withValue(context, operation: operation)
+    }
 }
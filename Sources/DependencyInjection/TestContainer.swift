@@ -9,42 +9,126 @@ import ServiceContextModule
 import DispatchInterpose
 import Atomics
 
-// File-level atomics for concurrent withTestContainer race condition protection
-private let _fatalErrorOnResolveRefCount = ManagedAtomic<Int>(0)
-private nonisolated(unsafe) var _originalFatalErrorOnResolveValue: Bool = false
-private let _fatalErrorOnResolveValueSaved = ManagedAtomic<Bool>(false)
+// The number of active test containers, shifted left one bit, packed with the default
+// container's `fatalErrorOnResolve` as it was before the first of them entered. Entries and exits
+// that leave a test container active only CAS the count. The first entry and the last exit also
+// save or restore the flag, so they serialize on `testContainerScopeLock`: a new first entrant
+// can't save the overridden value while a last exit is still restoring it.
+private let testContainerScope = ManagedAtomic(0)
+private let testContainerScopeLock = TrackedLock(site: "TestContainerScope")
+
+private let testContainerScopeSavedFlag = 1
+private let testContainerScopeCountUnit = 2
+
+private func activeTestContainerCount(_ state: Int) -> Int {
+    state / testContainerScopeCountUnit
+}
+
+/// Marks a test container as active, making the default container fatal error on resolve.
+private func enterTestContainerScope() {
+    var state = testContainerScope.load(ordering: .acquiring)
+    while activeTestContainerCount(state) > 0 {
+        let (exchanged, original) = testContainerScope.compareExchange(expected: state,
+                                                                       desired: state + testContainerScopeCountUnit,
+                                                                       ordering: .acquiringAndReleasing)
+        if exchanged { return }
+        state = original
+    }
+    testContainerScopeLock.protect {
+        // Only the lock holder moves the count off zero, so if it is still zero it stays there,
+        // and a nonzero count can only have been raised by an entry that already set the flag.
+        var state = testContainerScope.load(ordering: .acquiring)
+        while activeTestContainerCount(state) > 0 {
+            let (exchanged, original) = testContainerScope.compareExchange(expected: state,
+                                                                           desired: state + testContainerScopeCountUnit,
+                                                                           ordering: .acquiringAndReleasing)
+            if exchanged { return }
+            state = original
+        }
+        // First entrant - save the original value, and override it before publishing the count
+        let saved = Container.default.fatalErrorOnResolve ? testContainerScopeSavedFlag : 0
+        Container.default.fatalErrorOnResolve = true
+        testContainerScope.store(testContainerScopeCountUnit | saved, ordering: .releasing)
+    }
+}
+
+/// Balances ``enterTestContainerScope()``, restoring the default container once no test container is active.
+private func exitTestContainerScope() {
+    var state = testContainerScope.load(ordering: .acquiring)
+    while activeTestContainerCount(state) > 1 {
+        let (exchanged, original) = testContainerScope.compareExchange(expected: state,
+                                                                       desired: state - testContainerScopeCountUnit,
+                                                                       ordering: .acquiringAndReleasing)
+        if exchanged { return }
+        state = original
+    }
+    testContainerScopeLock.protect {
+        // Entries may still raise the count concurrently, but only the lock holder takes it to zero.
+        var state = testContainerScope.load(ordering: .acquiring)
+        while true {
+            let desired = activeTestContainerCount(state) > 1 ? state - testContainerScopeCountUnit : 0
+            let (exchanged, original) = testContainerScope.compareExchange(expected: state,
+                                                                           desired: desired,
+                                                                           ordering: .acquiringAndReleasing)
+            if exchanged { break }
+            state = original
+        }
+        if activeTestContainerCount(state) == 1 {
+            // Last exit - restore the original value
+            Container.default.fatalErrorOnResolve = state & testContainerScopeSavedFlag != 0
+        }
+    }
+}
+
+// With `DI_KEEP_DISPATCH_HOOKS=true`, the dispatch hooks stay bound after the last test
+// container exits, so GCD work a test leaked still runs in its test container (and reaches its
+// leaked-resolution behavior) instead of the default container. Off by default, because the
+// hooks then interpose every dispatch for the rest of the process.
+private let keepsDispatchHooksInstalled = ProcessInfo.processInfo.environment["DI_KEEP_DISPATCH_HOOKS"] == "true"
+
+/// Balances the `swift_async_hooks_install()` of a `withTestContainer` call.
+private func releaseDispatchHooks() {
+    guard !keepsDispatchHooksInstalled else { return }
+    swift_async_hooks_uninstall()
+}
 
 final class TestContainer: Container, @unchecked Sendable {
-    private let lock = NSRecursiveLock()
     let unregisteredBehavior: UnregisteredBehavior
     let leakedResolutionBehavior: any LeakedResolutionBehavior
     let _parent: Container
-    private var storage = [AnyHashable: StorageBase]()
     let testContainerFile: String
     let testContainerLine: UInt
     let testContainerFunction: String
 
     private var _executingTest = ManagedAtomic(false)
     var executingTest: Bool {
-        get { _executingTest.load(ordering: .sequentiallyConsistent) }
-        set { _executingTest.store(newValue, ordering: .sequentiallyConsistent) }
+        get { _executingTest.load(ordering: .acquiring) }
+        set { _executingTest.store(newValue, ordering: .releasing) }
+    }
+
+    // Resolutions outside the test body go through the leaked-resolution behavior. A test
+    // container never falls back to its parent, so the parent's checks don't apply.
+    override var memoizesResolutions: Bool {
+        executingTest
     }
 
-    init(parent: Container, unregisteredBehavior: UnregisteredBehavior, leakedResolutionBehavior: any LeakedResolutionBehavior, file: String = #file, line: UInt = #line, function: String = #function) {
+    init(parent: Container, registry: Registry = .empty, unregisteredBehavior: UnregisteredBehavior, leakedResolutionBehavior: any LeakedResolutionBehavior, file: String = #file, line: UInt = #line, function: String = #function) {
         self.unregisteredBehavior = unregisteredBehavior
         self.leakedResolutionBehavior = leakedResolutionBehavior
         self._parent = parent
         self.testContainerFile = file
         self.testContainerLine = line
         self.testContainerFunction = function
-        super.init(parent: parent)
+        super.init(parent: parent, registry: registry)
+        // Walks stop here, so registrations above a test container can't affect its descendants.
+        hierarchy = HierarchyVersion()
     }
 
     override func resolve<D>(factory: SyncFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) -> D {
         let storage = storage(for: factory)
         guard storage?.useProduction != true else { return factory.resolver() }
-        if let registered = storage?.syncRegistrations.currentResolver() {
-            return factory.scope.resolve(resolver: registered)
+        if let registered = storage?.registrations.currentResolver {
+            return scopeResolve(factory, resolver: registered)
         }
 
         #if DEBUG
@@ -65,8 +149,8 @@ final class TestContainer: Container, @unchecked Sendable {
     override func resolve<D>(factory: SyncThrowingFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) throws -> D {
         let storage = storage(for: factory)
         guard storage?.useProduction != true else { return try factory.resolver() }
-        if let registered = storage?.syncThrowingRegistrations.currentResolver() {
-            return try factory.scope.resolve(resolver: registered)
+        if let registered = storage?.registrations.currentResolver {
+            return try scopeResolve(factory, resolver: registered)
         }
 
         #if DEBUG
@@ -87,8 +171,8 @@ final class TestContainer: Container, @unchecked Sendable {
     override func resolve<D>(factory: AsyncFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) async -> D {
         let storage = storage(for: factory)
         guard storage?.useProduction != true else { return await factory.resolver() }
-        if let registered = storage?.asyncRegistrations.currentResolver() {
-            return await factory.scope.resolve(resolver: registered)
+        if let registered = storage?.registrations.currentResolver {
+            return await scopeResolve(factory, resolver: registered)
         }
 
         #if DEBUG
@@ -109,8 +193,8 @@ final class TestContainer: Container, @unchecked Sendable {
     override func resolve<D>(factory: AsyncThrowingFactory<D>, hasTaskLocalContext: Bool = false, file: String = #file, line: UInt = #line, function: String = #function) async throws -> D {
         let storage = storage(for: factory)
         guard storage?.useProduction != true else { return try await factory.resolver() }
-        if let registered = storage?.asyncThrowingRegistrations.currentResolver() {
-            return try await factory.scope.resolve(resolver: registered)
+        if let registered = storage?.registrations.currentResolver {
+            return try await scopeResolve(factory, resolver: registered)
         }
 
         #if DEBUG
@@ -127,26 +211,6 @@ final class TestContainer: Container, @unchecked Sendable {
         }
         return try await factory.resolver()
     }
-
-    override func addResolver<D>(for factory: SyncFactory<D>, resolver: @escaping SyncFactory<D>.Resolver) {
-        storage(for: factory)?.syncRegistrations.add(resolver: resolver)
-    }
-
-    override func addResolver<D>(for factory: SyncThrowingFactory<D>, resolver: @escaping SyncThrowingFactory<D>.Resolver) {
-        storage(for: factory)?.syncThrowingRegistrations.add(resolver: resolver)
-    }
-
-    override func addResolver<D>(for factory: AsyncFactory<D>, resolver: @escaping AsyncFactory<D>.Resolver) {
-        storage(for: factory)?.asyncRegistrations.add(resolver: resolver)
-    }
-
-    override func addResolver<D>(for factory: AsyncThrowingFactory<D>, resolver: @escaping AsyncThrowingFactory<D>.Resolver) {
-        storage(for: factory)?.asyncThrowingRegistrations.add(resolver: resolver)
-    }
-
-    override func storage<F: _Factory>(for factory: F) -> Storage<F>? {
-        register(factory: factory) as? Container.Storage<F>
-    }
 }
 
 /// The strategy a ``LeakedResolutionBehavior`` returns to handle a leaked resolution.
@@ -384,6 +448,10 @@ public enum UnregisteredBehavior {
 /// ``LeakedResolutionBehavior`` is triggered. By default this crashes; set the
 /// `DI_BEST_EFFORT_LEAK_RESOLUTION=true` environment variable for graceful recovery.
 ///
+/// GCD work is wrapped into the test container while any test container is active. Set
+/// `DI_KEEP_DISPATCH_HOOKS=true` to keep wrapping it after the last one exits, so work leaked
+/// from the final test is still caught.
+///
 /// - Parameters:
 ///   - defaults: Optional ``TestDefaults`` to pre-register in the test container.
 ///   - unregisteredBehavior: What to do when a factory has no test double. Defaults to ``UnregisteredBehavior/fatalError``.
@@ -401,27 +469,14 @@ public func withTestContainer<T>(defaults: TestDefaults? = nil,
                                  file: String = #file, line: UInt = #line, function: String = #function,
                                  operation: () throws -> T) rethrows -> T {
     swift_async_hooks_install()
+    defer { releaseDispatchHooks() }
     var context = ServiceContext.inUse
+    enterTestContainerScope()
+    defer { exitTestContainerScope() }
 
-    // Atomic reference counting solution to fix race condition
-    let refCount = _fatalErrorOnResolveRefCount.wrappingIncrementThenLoad(ordering: .sequentiallyConsistent)
-    if refCount == 1 {
-        // First entrant - capture and store the original value
-        _originalFatalErrorOnResolveValue = Container.default.fatalErrorOnResolve
-        _fatalErrorOnResolveValueSaved.store(true, ordering: .sequentiallyConsistent)
-        Container.default.fatalErrorOnResolve = true
-    }
-
-    defer {
-        let refCount = _fatalErrorOnResolveRefCount.wrappingDecrementThenLoad(ordering: .sequentiallyConsistent)
-        if refCount == 0 {
-            // Last exit - restore the original value and clear saved flag
-            Container.default.fatalErrorOnResolve = _originalFatalErrorOnResolveValue
-            _fatalErrorOnResolveValueSaved.store(false, ordering: .sequentiallyConsistent)
-        }
-    }
-
-    let testContainer = TestContainer(parent: Container(parent: Container.current),
+    // A test container never falls back to its parent, so it can hang directly off the current container.
+    let testContainer = TestContainer(parent: Container.current,
+                                      registry: defaults?.registry ?? .empty,
                                       unregisteredBehavior: unregisteredBehavior,
                                       leakedResolutionBehavior: leakedResolutionBehavior,
                                       file: file, line: line, function: function)
@@ -429,7 +484,6 @@ public func withTestContainer<T>(defaults: TestDefaults? = nil,
     return try ServiceContext.withValue(context, operation: {
         testContainer.executingTest = true
         defer { testContainer.executingTest = false }
-        defaults?.apply(to: testContainer)
         return try operation()
     })
 }
@@ -467,27 +521,14 @@ public func withTestContainer<T>(isolation: isolated(any Actor)? = #isolation,
                                  file: String = #file, line: UInt = #line, function: String = #function,
                                  operation: () async throws -> T) async rethrows -> T {
     swift_async_hooks_install()
+    defer { releaseDispatchHooks() }
     var context = ServiceContext.inUse
+    enterTestContainerScope()
+    defer { exitTestContainerScope() }
 
-    // Atomic reference counting solution to fix race condition
-    let refCount = _fatalErrorOnResolveRefCount.wrappingIncrementThenLoad(ordering: .sequentiallyConsistent)
-    if refCount == 1 {
-        // First entrant - capture and store the original value
-        _originalFatalErrorOnResolveValue = Container.default.fatalErrorOnResolve
-        _fatalErrorOnResolveValueSaved.store(true, ordering: .sequentiallyConsistent)
-        Container.default.fatalErrorOnResolve = true
-    }
-
-    defer {
-        let refCount = _fatalErrorOnResolveRefCount.wrappingDecrementThenLoad(ordering: .sequentiallyConsistent)
-        if refCount == 0 {
-            // Last exit - restore the original value and clear saved flag
-            Container.default.fatalErrorOnResolve = _originalFatalErrorOnResolveValue
-            _fatalErrorOnResolveValueSaved.store(false, ordering: .sequentiallyConsistent)
-        }
-    }
-
-    let testContainer = TestContainer(parent: Container(parent: Container.current),
+    // A test container never falls back to its parent, so it can hang directly off the current container.
+    let testContainer = TestContainer(parent: Container.current,
+                                      registry: defaults?.registry ?? .empty,
                                       unregisteredBehavior: unregisteredBehavior,
                                       leakedResolutionBehavior: leakedResolutionBehavior,
                                       file: file, line: line, function: function)
@@ -495,7 +536,6 @@ public func withTestContainer<T>(isolation: isolated(any Actor)? = #isolation,
     return try await ServiceContext.withValue(context, operation: {
         testContainer.executingTest = true
         defer { testContainer.executingTest = false }
-        defaults?.apply(to: testContainer)
         return try await operation()
     })
 }
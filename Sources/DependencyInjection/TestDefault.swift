@@ -5,6 +5,8 @@
 //  Created by Tyler Thompson on 10/18/25.
 //
 
+import Foundation
+
 /// A single factory-to-resolver binding for use in test defaults.
 ///
 /// Create instances using the `testValue(_:)` method on any factory type:
@@ -35,7 +37,6 @@ public extension SyncFactory {
     func testValue(_ resolver: @escaping Resolver) -> FactoryDefault {
         FactoryDefault { [weak self] c in
             guard let self else { return }
-            (self.scope as? ScopeWithCache)?.cache.clear()
             c.addResolver(for: self, resolver: resolver)
         }
     }
@@ -49,7 +50,6 @@ public extension SyncThrowingFactory {
     func testValue(_ resolver: @escaping Resolver) -> FactoryDefault {
         FactoryDefault { [weak self] c in
             guard let self else { return }
-            (self.scope as? ScopeWithCache)?.cache.clear()
             c.addResolver(for: self, resolver: resolver)
         }
     }
@@ -63,7 +63,6 @@ public extension AsyncFactory {
     func testValue(_ resolver: @escaping Resolver) -> FactoryDefault {
         FactoryDefault { [weak self] c in
             guard let self else { return }
-            (self.scope as? ScopeWithCache)?.cache.clear()
             c.addResolver(for: self, resolver: resolver)
         }
     }
@@ -77,7 +76,6 @@ public extension AsyncThrowingFactory {
     func testValue(_ resolver: @escaping Resolver) -> FactoryDefault {
         FactoryDefault { [weak self] c in
             guard let self else { return }
-            (self.scope as? ScopeWithCache)?.cache.clear()
             c.addResolver(for: self, resolver: resolver)
         }
     }
@@ -95,6 +93,7 @@ public enum TestDefaultBuilder {
     public static func buildOptional(_ component: [FactoryDefault]?) -> [FactoryDefault] { component ?? [] }
     public static func buildEither(first: [FactoryDefault]) -> [FactoryDefault] { first }
     public static func buildEither(second: [FactoryDefault]) -> [FactoryDefault] { second }
+    public static func buildArray(_ components: [[FactoryDefault]]) -> [FactoryDefault] { components.flatMap { $0 } }
 }
 
 /// A result builder for composing ``TestDefault`` and ``TestDefaults`` values.
@@ -108,6 +107,7 @@ public enum TestDefaultsBuilder {
     public static func buildOptional(_ component: [AnyTestDefaults]?) -> [AnyTestDefaults] { component ?? [] }
     public static func buildEither(first: [AnyTestDefaults]) -> [AnyTestDefaults] { first }
     public static func buildEither(second: [AnyTestDefaults]) -> [AnyTestDefaults] { second }
+    public static func buildArray(_ components: [[AnyTestDefaults]]) -> [AnyTestDefaults] { components.flatMap { $0 } }
 }
 
 // MARK: Composable containers
@@ -169,9 +169,38 @@ public struct TestDefaults: Sendable, ExpressibleByArrayLiteral {
     }
 
     fileprivate let groups: [AnyTestDefaults]
+    private let compiled = CompiledTestDefaults()
     public init(@TestDefaultsBuilder _ make: () -> [AnyTestDefaults]) { self.groups = make() }
     func apply(to c: Container) { groups.forEach { $0.apply(to: c) } }
     fileprivate func erase() -> AnyTestDefaults { AnyTestDefaults { self.apply(to: $0) } }
+
+    /// The registrations these defaults make, built the first time they are needed.
+    ///
+    /// Every test container created with the same `TestDefaults` value starts from this
+    /// snapshot. Published storage is never mutated, so a test that registers over a default
+    /// copies only that factory's storage and leaves the snapshot intact for other tests.
+    var registry: Container.Registry {
+        compiled.registry {
+            let scratch = Container()
+            apply(to: scratch)
+            return scratch.registrySnapshot
+        }
+    }
+}
+
+/// Lazily built, shared registry snapshot of a ``TestDefaults`` value.
+private final class CompiledTestDefaults: @unchecked Sendable {
+    private let lock = TrackedLock(site: "TestDefaults")
+    private var registry: Container.Registry?
+
+    func registry(_ compile: () -> Container.Registry) -> Container.Registry {
+        lock.protect {
+            if let registry { return registry }
+            let compiled = compile()
+            registry = compiled
+            return compiled
+        }
+    }
 }
 
 /// A type-erased wrapper for ``TestDefault`` or ``TestDefaults``.
@@ -0,0 +1,90 @@
+//
+//  Benchmark.swift
+//  DependencyInjectionBenchmarks
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+
+/// A named operation measured over repeated samples.
+///
+/// `iterations` is how many times the body performs the operation under test per sample;
+/// results are reported per iteration so they can be compared across benchmarks.
+struct Benchmark {
+    enum Body {
+        case sync((Int) -> Void)
+        case async((Int) async -> Void)
+    }
+
+    let name: String
+    let iterations: Int
+    let body: Body
+
+    static func sync(_ name: String, iterations: Int, _ body: @escaping (Int) -> Void) -> Benchmark {
+        Benchmark(name: name, iterations: iterations, body: .sync(body))
+    }
+
+    static func async(_ name: String, iterations: Int, _ body: @escaping (Int) async -> Void) -> Benchmark {
+        Benchmark(name: name, iterations: iterations, body: .async(body))
+    }
+
+    func run() async {
+        switch body {
+        case .sync(let body): body(iterations)
+        case .async(let body): await body(iterations)
+        }
+    }
+
+    func measure(samples: Int) async -> BenchmarkResult {
+        let clock = ContinuousClock()
+        await run() // warm up caches, lazy statics and the allocator
+        var nanosecondsPerIteration = [Double]()
+        nanosecondsPerIteration.reserveCapacity(samples)
+        for _ in 0..<samples {
+            let start = clock.now
+            await run()
+            let elapsed = start.duration(to: clock.now)
+            nanosecondsPerIteration.append(elapsed.nanoseconds / Double(iterations))
+        }
+        nanosecondsPerIteration.sort()
+        return BenchmarkResult(name: name,
+                               iterations: iterations,
+                               samples: samples,
+                               medianNanosecondsPerIteration: nanosecondsPerIteration[nanosecondsPerIteration.count / 2],
+                               minNanosecondsPerIteration: nanosecondsPerIteration[0],
+                               maxNanosecondsPerIteration: nanosecondsPerIteration[nanosecondsPerIteration.count - 1])
+    }
+}
+
+/// The machine-readable result of a single benchmark.
+struct BenchmarkResult: Codable {
+    let name: String
+    let iterations: Int
+    let samples: Int
+    let medianNanosecondsPerIteration: Double
+    let minNanosecondsPerIteration: Double
+    let maxNanosecondsPerIteration: Double
+}
+
+/// The full report written by the benchmark runner. Bump `schemaVersion` when the shape changes.
+struct BenchmarkReport: Codable {
+    var schemaVersion = 1
+    let configuration: String
+    let results: [BenchmarkResult]
+}
+
+/// Keeps the optimizer from discarding a value that is produced only to be measured.
+///
+/// `@inline(never)` alone isn't enough: an empty body in the same module can still be seen
+/// through (and specialized away), so the function is also left unoptimized.
+@inline(never)
+@_optimize(none)
+func blackHole<T>(_ value: T) { }
+
+extension Duration {
+    var nanoseconds: Double {
+        let (seconds, attoseconds) = components
+        return Double(seconds) * 1_000_000_000 + Double(attoseconds) / 1_000_000_000
+    }
+}
@@ -0,0 +1,62 @@
+//
+//  BenchmarkRunner.swift
+//  DependencyInjectionBenchmarks
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+
+/// Runs the benchmark suite and writes a JSON report.
+///
+/// ```
+/// swift run -c release DependencyInjectionBenchmarks [--filter <substring>] [--samples <n>] [--output <path>]
+/// ```
+///
+/// The report goes to standard output unless `--output` is given; progress goes to standard error,
+/// so two runs can be diffed directly.
+@main
+struct BenchmarkRunner {
+    struct Options {
+        var filter: String?
+        var samples = 10
+        var output: String?
+
+        init(arguments: some Sequence<String>) {
+            var arguments = arguments.makeIterator()
+            while let argument = arguments.next() {
+                switch argument {
+                case "--filter": filter = arguments.next()
+                case "--samples": samples = arguments.next().flatMap(Int.init).map { max($0, 1) } ?? samples
+                case "--output": output = arguments.next()
+                default: FileHandle.standardError.write(Data("Ignoring unknown argument \(argument)\n".utf8))
+                }
+            }
+        }
+    }
+
+    static func main() async throws {
+        let options = Options(arguments: CommandLine.arguments.dropFirst())
+        var results = [BenchmarkResult]()
+        for benchmark in Suite.all() where options.filter.map(benchmark.name.contains) ?? true {
+            let result = await benchmark.measure(samples: options.samples)
+            FileHandle.standardError.write(Data("\(result.name): \(result.medianNanosecondsPerIteration) ns/iteration\n".utf8))
+            results.append(result)
+        }
+
+        #if DEBUG
+        let configuration = "debug"
+        #else
+        let configuration = "release"
+        #endif
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = [.prettyPrinted, .sortedKeys]
+        let data = try encoder.encode(BenchmarkReport(configuration: configuration, results: results))
+        if let output = options.output {
+            try data.write(to: URL(fileURLWithPath: output))
+        } else {
+            FileHandle.standardOutput.write(data)
+            FileHandle.standardOutput.write(Data("\n".utf8))
+        }
+    }
+}
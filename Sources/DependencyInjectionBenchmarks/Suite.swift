@@ -0,0 +1,124 @@
+//
+//  Suite.swift
+//  DependencyInjectionBenchmarks
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+import DependencyInjection
+
+final class Service: Sendable { }
+
+enum BenchmarkFactories {
+    static let unique = Factory { Service() }
+    static let cached = Factory(scope: .cached) { Service() }
+    static let shared = Factory(scope: .shared) { Service() }
+    static let asyncUnique = Factory { () async in Service() }
+    static let asyncCached = Factory(scope: .cached) { () async in Service() }
+    static let asyncShared = Factory(scope: .shared) { () async in Service() }
+
+    /// Factories used to build large ``TestDefaults`` for test container setup benchmarks.
+    static let testDefaults = (0..<300).map { i in Factory { i } }
+}
+
+enum Suite {
+    static func all() -> [Benchmark] {
+        resolution() + nesting() + contention() + registration() + testContainers()
+    }
+
+    static func resolution() -> [Benchmark] {
+        [
+            .sync("resolve.sync.unique", iterations: 100_000) { n in
+                for _ in 0..<n { blackHole(BenchmarkFactories.unique()) }
+            },
+            .sync("resolve.sync.cached", iterations: 100_000) { n in
+                for _ in 0..<n { blackHole(BenchmarkFactories.cached()) }
+            },
+            .sync("resolve.sync.shared", iterations: 100_000) { n in
+                let held = BenchmarkFactories.shared()
+                for _ in 0..<n { blackHole(BenchmarkFactories.shared()) }
+                withExtendedLifetime(held) { }
+            },
+            .async("resolve.async.unique", iterations: 100_000) { n in
+                for _ in 0..<n { blackHole(await BenchmarkFactories.asyncUnique()) }
+            },
+            .async("resolve.async.cached", iterations: 100_000) { n in
+                for _ in 0..<n { blackHole(await BenchmarkFactories.asyncCached()) }
+            },
+            .async("resolve.async.shared", iterations: 100_000) { n in
+                let held = await BenchmarkFactories.asyncShared()
+                for _ in 0..<n { blackHole(await BenchmarkFactories.asyncShared()) }
+                withExtendedLifetime(held) { }
+            },
+        ]
+    }
+
+    /// Resolution of a factory overridden `depth` containers above the current one.
+    static func nesting() -> [Benchmark] {
+        [1, 2, 4, 6, 8].map { depth in
+            .sync("resolve.nested.depth\(depth)", iterations: 100_000) { n in
+                withNestedContainer {
+                    BenchmarkFactories.unique.register { Service() }
+                    withNestedContainers(depth: depth) {
+                        for _ in 0..<n { blackHole(BenchmarkFactories.unique()) }
+                    }
+                }
+            }
+        }
+    }
+
+    /// `threads` threads each resolving the same warm cached factory `iterations` times.
+    /// Reported time is wall time divided by the per-thread iteration count.
+    static func contention() -> [Benchmark] {
+        [1, 2, 4, 8].map { threads in
+            .sync("contention.sync.cached.threads\(threads)", iterations: 100_000) { n in
+                blackHole(BenchmarkFactories.cached())
+                DispatchQueue.concurrentPerform(iterations: threads) { _ in
+                    for _ in 0..<n { blackHole(BenchmarkFactories.cached()) }
+                }
+            }
+        }
+    }
+
+    static func registration() -> [Benchmark] {
+        [
+            .sync("registration.registerThenPop", iterations: 100_000) { n in
+                withNestedContainer {
+                    for _ in 0..<n {
+                        BenchmarkFactories.unique.register { Service() }
+                        BenchmarkFactories.unique.popRegistration()
+                    }
+                }
+            },
+            .sync("container.withNestedContainer", iterations: 100_000) { n in
+                for _ in 0..<n {
+                    withNestedContainer { blackHole(BenchmarkFactories.unique()) }
+                }
+            },
+        ]
+    }
+
+    /// Entering and leaving a test container that applies `count` test defaults.
+    static func testContainers() -> [Benchmark] {
+        [0, 30, 300].map { count in
+            let defaults = TestDefaults {
+                TestDefault {
+                    for factory in BenchmarkFactories.testDefaults.prefix(count) {
+                        factory.testValue { -1 }
+                    }
+                }
+            }
+            return .sync("testContainer.setup.defaults\(count)", iterations: 1_000) { n in
+                for _ in 0..<n {
+                    withTestContainer(defaults: defaults) { }
+                }
+            }
+        }
+    }
+
+    private static func withNestedContainers(depth: Int, _ body: () -> Void) {
+        guard depth > 0 else { return body() }
+        withNestedContainer { withNestedContainers(depth: depth - 1, body) }
+    }
+}
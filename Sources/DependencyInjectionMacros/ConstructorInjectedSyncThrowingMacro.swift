@@ -39,7 +39,7 @@ public struct ConstructorInjectedSyncThrowingMacro: PeerMacro, AccessorMacro {
         }
 
         let name = identifierPattern.identifier.text
-        let privateName = "_" + name
+        let privateName = backingStorageName(for: name, attribute: node)
 
         return [
             AccessorDeclSyntax("get { \(raw: privateName).wrappedValue }")
@@ -0,0 +1,77 @@
+//
+//  ConstructorInjectionMacro.swift
+//  DependencyInjection
+//
+//  Created by Tyler Thompson on 10/14/26.
+//
+
+import Foundation
+import SwiftSyntax
+import SwiftSyntaxBuilder
+import SwiftSyntaxMacros
+
+public struct ConstructorInjectionMacro: MemberMacro {
+    // Emits, for every `@ConstructorInjected(..., batched: true)` property:
+    // - private struct _ConstructorInjection { let dependency: ConstructorInjectedResolver<...>; init(...) { dependency = BoundResolver.withCurrent { ... } } }
+    // - private let _constructorInjection = _ConstructorInjection(file: #file, line: #line, function: #function)
+    public static func expansion(
+        of node: AttributeSyntax,
+        providingMembersOf declaration: some DeclGroupSyntax,
+        in context: some MacroExpansionContext
+    ) throws -> [DeclSyntax] {
+        let properties = try declaration.memberBlock.members.compactMap { member in
+            try batchedProperty(member.decl)
+        }
+        guard !properties.isEmpty else { return [] }
+
+        let storedProperties = properties.map { property in
+            "let \(property.name): ConstructorInjectedResolver<\(property.type), \(batchedFactoryTypeName(for: property.name))>"
+        }
+        // Every resolver is built inside one `BoundResolver.withCurrent` call, so the whole batch
+        // reads the container context once. The closure returns the resolvers as a tuple because
+        // it can't assign `self`'s properties before `init` finishes.
+        let names = properties.map(\.name)
+        let resolvers = properties.map { property in
+            "ConstructorInjectedResolver(\(property.factory), resolvingWith: resolve, file: file, line: line, function: function)"
+        }
+        let targets = names.count == 1 ? names[0] : "(\(names.joined(separator: ", ")))"
+        let values = resolvers.count == 1
+            ? resolvers[0]
+            : "(\n                \(resolvers.joined(separator: ",\n                "))\n            )"
+
+        return [
+            DeclSyntax(stringLiteral: """
+            private struct _ConstructorInjection {
+                \(storedProperties.joined(separator: "\n    "))
+
+                init(file: String, line: UInt, function: String) {
+                    \(targets) = BoundResolver.withCurrent { resolve in
+                        \(values)
+                    }
+                }
+            }
+            """),
+            DeclSyntax(stringLiteral: "private let _constructorInjection = _ConstructorInjection(file: #file, line: #line, function: #function)")
+        ]
+    }
+
+    private static func batchedProperty(_ decl: DeclSyntax) throws -> (name: String, type: String, factory: String)? {
+        guard let varDecl = decl.as(VariableDeclSyntax.self),
+              !varDecl.modifiers.contains(where: { ["static", "class"].contains($0.name.text) }),
+              varDecl.bindings.count == 1,
+              let binding = varDecl.bindings.first,
+              let identifierPattern = binding.pattern.as(IdentifierPatternSyntax.self),
+              let typeAnnotation = binding.typeAnnotation else {
+            return nil
+        }
+
+        let attribute = varDecl.attributes.lazy
+            .compactMap { $0.as(AttributeSyntax.self) }
+            .first { $0.attributeName.description.trimmingCharacters(in: .whitespacesAndNewlines) == "ConstructorInjected" && isBatched($0) }
+        guard let attribute else { return nil }
+
+        return (name: identifierPattern.identifier.text,
+                type: typeAnnotation.type.description.trimmingCharacters(in: .whitespacesAndNewlines),
+                factory: try factoryExpression(from: attribute))
+    }
+}
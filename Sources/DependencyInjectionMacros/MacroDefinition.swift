@@ -19,6 +19,7 @@ struct MyProjectMacros: CompilerPlugin {
         ConstructorInjectedSyncThrowingMacro.self,
         ConstructorInjectedAsyncMacro.self,
         ConstructorInjectedAsyncThrowingMacro.self,
+        ConstructorInjectionMacro.self,
         LazyInjectedSyncMacro.self,
         LazyInjectedSyncThrowingMacro.self,
         LazyInjectedAsyncMacro.self,
@@ -28,18 +28,33 @@ extension Macro {
         let projectedName = "$" + name
         let type = typeAnnotation.type.description.trimmingCharacters(in: .whitespacesAndNewlines)
         let factoryExpr = try factoryExpression(from: node)
+        let options = optionArguments(from: node)
 
-        // Get the factory type from @Injected<...>(...)
-        let innerType = innerTypeForFactory(declaredType: type)
+        // Get the factory type from @Injected<...>(...). A sync factory's value is the declared
+        // type itself, even when that is generic (e.g. a `Result` it returns rather than throws).
+        let innerType = factoryType == "SyncFactory" ? type : innerTypeForFactory(declaredType: type)
         let projectedType = "\(factoryType)<\(innerType)>"
         let modifiers = varDecl.modifiers.map { $0.description.trimmingCharacters(in: .whitespacesAndNewlines) }
         let modifiersExcludingAccess = modifiers.filter {
             !["public", "internal", "fileprivate", "private"].contains($0)
         }
 
+        // Batched properties are stored by the type's `@ConstructorInjection` expansion, which
+        // only sees the declared type, so the factory type is named here where it is known.
+        if isBatched(node) {
+            return [
+                DeclSyntax(stringLiteral: "private typealias \(batchedFactoryTypeName(for: name)) = \(projectedType)"),
+                DeclSyntax(stringLiteral: """
+                \(modifiers.joined(separator: " ")) var \(projectedName): \(projectedType) {
+                    \(backingStorageName(for: name, attribute: node)).projectedValue
+                }
+                """)
+            ]
+        }
+
         let modifierPrefix = modifiersExcludingAccess.joined(separator: " ")
         return [
-            DeclSyntax(stringLiteral: "private \(modifierPrefix) let \(privateName) = \(resolverType)(\(factoryExpr), file: #file, line: #line, function: #function)"),
+            DeclSyntax(stringLiteral: "private \(modifierPrefix) let \(privateName) = \(resolverType)(\(factoryExpr)\(options), file: #file, line: #line, function: #function)"),
             DeclSyntax(stringLiteral: """
             \(modifiers.joined(separator: " ")) var \(projectedName): \(projectedType) {
                 \(privateName).projectedValue
@@ -57,6 +72,44 @@ extension Macro {
         return first.expression.description.trimmingCharacters(in: .whitespacesAndNewlines)
     }
     
+    /// Whether `attr` passes `batched: true`, leaving storage to the enclosing `@ConstructorInjection`.
+    static func isBatched(_ attr: AttributeSyntax) -> Bool {
+        guard let arguments = attr.arguments?.as(LabeledExprListSyntax.self) else {
+            return false
+        }
+
+        return arguments.contains {
+            $0.label?.text == "batched" && $0.expression.description.trimmingCharacters(in: .whitespacesAndNewlines) == "true"
+        }
+    }
+
+    /// The expression that holds the resolver backing the property `name`.
+    static func backingStorageName(for name: String, attribute attr: AttributeSyntax) -> String {
+        isBatched(attr) ? "_constructorInjection.\(name)" : "_" + name
+    }
+
+    /// Arguments after the factory (e.g. `startsOnFirstAccess: true`), forwarded verbatim to the
+    /// resolver's initializer with a leading `, `. Empty when only the factory is given.
+    /// `batched:` only affects the expansion, so it is not forwarded.
+    static func optionArguments(from attr: AttributeSyntax) -> String {
+        guard let arguments = attr.arguments?.as(LabeledExprListSyntax.self) else {
+            return ""
+        }
+
+        return arguments.dropFirst().filter { $0.label?.text != "batched" }.map { argument in
+            let expression = argument.expression.description.trimmingCharacters(in: .whitespacesAndNewlines)
+            guard let label = argument.label?.text else { return ", \(expression)" }
+            return ", \(label): \(expression)"
+        }.joined()
+    }
+    
+    /// The typealias a batched property's peer expansion declares for its factory type, so the
+    /// `@ConstructorInjection` expansion never has to infer it from the declared type. It takes
+    /// the `_name` the unbatched backing storage would have used.
+    static func batchedFactoryTypeName(for name: String) -> String {
+        "_" + name
+    }
+
     static func innerTypeForFactory(declaredType: String) -> String {
         guard let genericStart = declaredType.firstIndex(of: "<"),
               let genericEnd = declaredType.lastIndex(of: ">") else {
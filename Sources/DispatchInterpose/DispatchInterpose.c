@@ -31,8 +31,15 @@ static void new_async_after(void *deadline, void *qos, void *flags, void *block)
     orig_async_after(deadline, qos, flags, wrapped);
 }
 
-// Thread-safe deferred installer using pthread_once instead of dispatch_once
-static pthread_once_t once_control = PTHREAD_ONCE_INIT;
+// Only images that link the Swift Dispatch overlay can reference the hooked symbols
+static bool links_swift_dispatch(const struct mach_header *header) {
+    return rebind_image_links_library(header, "libswiftDispatch.dylib");
+}
+
+// Hooks are refcounted: bound while at least one install is outstanding, restored at zero.
+// A pthread mutex rather than dispatch, which is what we are hooking.
+static pthread_mutex_t hooks_lock = PTHREAD_MUTEX_INITIALIZER;
+static size_t hooks_refcount = 0;
 
 static void install_hooks(void) {
     struct rebinding rebindings[] = {
@@ -49,11 +56,30 @@ static void install_hooks(void) {
             (void **)&orig_async_after
         }
     };
-    rebind_symbols(rebindings, sizeof(rebindings) / sizeof(rebindings[0]));
+    rebind_symbols_filtered(rebindings, sizeof(rebindings) / sizeof(rebindings[0]), links_swift_dispatch);
 }
 
 void swift_async_hooks_install(void) {
-    pthread_once(&once_control, install_hooks);
+    pthread_mutex_lock(&hooks_lock);
+    if (hooks_refcount++ == 0) {
+        install_hooks();
+    }
+    pthread_mutex_unlock(&hooks_lock);
+}
+
+void swift_async_hooks_uninstall(void) {
+    pthread_mutex_lock(&hooks_lock);
+    if (hooks_refcount > 0 && --hooks_refcount == 0) {
+        unbind_symbols();
+    }
+    pthread_mutex_unlock(&hooks_lock);
+}
+
+bool swift_async_hooks_installed(void) {
+    pthread_mutex_lock(&hooks_lock);
+    bool installed = hooks_refcount > 0;
+    pthread_mutex_unlock(&hooks_lock);
+    return installed;
 }
 
 #else
@@ -62,4 +88,12 @@ void swift_async_hooks_install(void) {
     // No-op on non-Darwin platforms
 }
 
+void swift_async_hooks_uninstall(void) {
+    // No-op on non-Darwin platforms
+}
+
+bool swift_async_hooks_installed(void) {
+    return false;
+}
+
 #endif // DEBUG && (__APPLE__ || __MACH__)
@@ -18,7 +18,11 @@
 extern "C" {
 #endif
 
+// Refcounted: hooks are active while installs outnumber uninstalls and are removed at zero.
 void swift_async_hooks_install(void);
+void swift_async_hooks_uninstall(void);
+// True while at least one install is outstanding.
+bool swift_async_hooks_installed(void);
 
 #ifdef __cplusplus
 }
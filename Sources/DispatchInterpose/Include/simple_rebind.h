@@ -1,6 +1,7 @@
 // simple_rebind.h
 #pragma once
 #include <stddef.h>
+#include <stdbool.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -12,9 +13,36 @@ struct rebinding {
   void **replaced;      // out: original function (may be NULL)
 };
 
+struct mach_header;
+
+// Decides whether an image should be rebound; return false to skip it without scanning.
+typedef bool (*rebind_image_filter)(const struct mach_header *header);
+
+// What rebinding one image cost: slots patched and pages whose protection was changed.
+struct rebind_image_stats {
+  size_t patched_slots;
+  size_t protected_pages;
+};
+
 // Rebind all symbols in all loaded images.
 int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel);
 
+// Rebind symbols only in loaded (and later loaded) images accepted by `filter` (NULL accepts all).
+int rebind_symbols_filtered(struct rebinding rebindings[], size_t rebindings_nel, rebind_image_filter filter);
+
+// True when the image has a load command for a dylib whose file name is `library_name`
+// (e.g. "libswiftDispatch.dylib"). Useful as the body of a `rebind_image_filter`.
+bool rebind_image_links_library(const struct mach_header *header, const char *library_name);
+
+// Fills `stats` for the image whose mach header is at `header` (e.g. Swift's `#dsohandle`)
+// from its last scan that patched slots, or with zeros if none did. Returns false if the image
+// was never scanned, such as one the filter rejected.
+bool rebind_get_image_stats(const void *header, struct rebind_image_stats *stats);
+
+// Restores every slot patched since the last rebind and stops rebinding newly loaded images
+// until the next rebind_symbols call. Returns the number of slots restored.
+size_t unbind_symbols(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -12,6 +12,8 @@
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <stdatomic.h>
 
 #if defined(__arm64e__)
 #include <ptrauth.h>
@@ -35,45 +37,174 @@ typedef struct nlist nlist_t;
 #define SEG_DATA_CONST "__DATA_CONST"
 #endif
 
+// A rebinding with its name's length and hash precomputed, so matching a symbol is a
+// hash/length compare and only a true candidate pays for memcmp.
+struct prepared_rebinding {
+    struct rebinding rebinding;
+    size_t name_len;
+    uint32_t name_hash;
+};
+
+struct rebinding_table {
+    struct prepared_rebinding *entries;
+    size_t nel;
+    size_t max_name_len;
+    rebind_image_filter filter;
+};
+
 // ----- global (heap-copied) table + lock -----
-static struct rebinding *g_rebindings = NULL;
-static size_t g_rebindings_nel = 0;
+static struct rebinding_table *g_table = NULL;
 static os_unfair_lock g_lock = OS_UNFAIR_LOCK_INIT;
+// False after unbind_symbols; the dyld callback checks it before doing any work.
+static atomic_bool g_active = false;
+// What the last patching scan of each image cost, for rebind_get_image_stats. Guarded by g_lock.
+struct image_record {
+    const void *header;
+    struct rebind_image_stats stats;
+};
+static struct image_record *g_images = NULL;
+static size_t g_image_count = 0;
+static size_t g_image_capacity = 0;
+
+// Every slot we overwrote and the value it held, so unbind_symbols can put them back.
+struct patched_slot {
+    void **slot;
+    void *original;
+};
+static struct patched_slot *g_patched = NULL;
+static size_t g_patched_count = 0;
+static size_t g_patched_capacity = 0;
+
+// 32-bit FNV-1a
+#define NAME_HASH_SEED 2166136261u
+static inline uint32_t name_hash_step(uint32_t hash, unsigned char c) {
+    return (hash ^ c) * 16777619u;
+}
+
+static struct rebinding_table *make_table(struct rebinding rebindings[], size_t rebindings_nel, rebind_image_filter filter) {
+    struct rebinding_table *table = (struct rebinding_table *)malloc(sizeof(struct rebinding_table));
+    if (!table) return NULL;
+    table->entries = (struct prepared_rebinding *)calloc(rebindings_nel, sizeof(struct prepared_rebinding));
+    if (!table->entries) {
+        free(table);
+        return NULL;
+    }
+    table->nel = 0;
+    table->max_name_len = 0;
+    table->filter = filter;
+    for (size_t i = 0; i < rebindings_nel; i++) {
+        const char *name = rebindings[i].name;
+        if (!name) continue;
+        struct prepared_rebinding *entry = &table->entries[table->nel++];
+        entry->rebinding = rebindings[i];
+        entry->name_len = strlen(name);
+        entry->name_hash = NAME_HASH_SEED;
+        for (size_t c = 0; c < entry->name_len; c++) {
+            entry->name_hash = name_hash_step(entry->name_hash, (unsigned char)name[c]);
+        }
+        if (entry->name_len > table->max_name_len) table->max_name_len = entry->name_len;
+    }
+    return table;
+}
+
+static void free_table(struct rebinding_table *table) {
+    if (!table) return;
+    free(table->entries);
+    free(table);
+}
+
+static bool tables_equal(const struct rebinding_table *a, const struct rebinding_table *b) {
+    if (!a || !b || a->nel != b->nel || a->filter != b->filter) return false;
+    for (size_t i = 0; i < a->nel; i++) {
+        const struct rebinding *x = &a->entries[i].rebinding;
+        const struct rebinding *y = &b->entries[i].rebinding;
+        if (x->replacement != y->replacement || x->replaced != y->replaced ||
+            a->entries[i].name_hash != b->entries[i].name_hash ||
+            strcmp(x->name, y->name) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Must hold g_lock.
+static bool record_patched_slot_locked(void **slot, void *original) {
+    if (g_patched_count == g_patched_capacity) {
+        size_t capacity = g_patched_capacity ? g_patched_capacity * 2 : 16;
+        struct patched_slot *grown = (struct patched_slot *)realloc(g_patched, capacity * sizeof(struct patched_slot));
+        if (!grown) return false;
+        g_patched = grown;
+        g_patched_capacity = capacity;
+    }
+    g_patched[g_patched_count++] = (struct patched_slot){ slot, original };
+    return true;
+}
+
+// Must hold g_lock. Returns false without writing if `table` was unbound or replaced while the
+// image was being scanned, or if the slot already points at the replacement (so the log never
+// records a replacement as an original).
+static bool patch_slot_locked(const struct rebinding_table *table,
+                              const struct prepared_rebinding *entry,
+                              void **slot) {
+    if (g_table != table || !atomic_load_explicit(&g_active, memory_order_relaxed)) return false;
+    
+    void *current = *slot;
+#if defined(__arm64e__)
+    // Strip ptrauth signature to get usable original function pointer
+    void *current_target = ptrauth_strip(current, ptrauth_key_function_pointer);
+    void *replacement_target = ptrauth_strip(entry->rebinding.replacement, ptrauth_key_function_pointer);
+#else
+    void *current_target = current;
+    void *replacement_target = entry->rebinding.replacement;
+#endif
+    if (current_target == replacement_target) return false;
+    // Never patch a slot we couldn't restore
+    if (!record_patched_slot_locked(slot, current)) return false;
+    
+    if (entry->rebinding.replaced && *entry->rebinding.replaced == NULL) {
+        *entry->rebinding.replaced = current_target;
+    }
+#if defined(__arm64e__)
+    // Sign replacement pointer with ptrauth before storing on arm64e
+    *slot = ptrauth_sign_unauthenticated(entry->rebinding.replacement, ptrauth_key_function_pointer, 0);
+#else
+    *slot = entry->rebinding.replacement;
+#endif
+    return true;
+}
 
-// Make the whole section containing stubs writable (page-aligned)
+// Make a single page containing matched slots writable.
 // Returns true on success, false on failure
-static inline bool make_section_writable(void *section_base, size_t section_size) {
-    vm_address_t addr = (vm_address_t)section_base;
-    vm_size_t len = (vm_size_t)section_size;
-    // vm_protect expects page-aligned, but will round; we pass the section base.
-    kern_return_t ret = vm_protect(mach_task_self(), addr, len, /*set_max_protection*/ 0,
+static inline bool make_page_writable(uintptr_t page) {
+    kern_return_t ret = vm_protect(mach_task_self(), (vm_address_t)page, (vm_size_t)vm_page_size,
+                                   /*set_max_protection*/ 0,
                                    VM_PROT_READ | VM_PROT_WRITE | VM_PROT_COPY);
     if (ret != KERN_SUCCESS) {
-        // Log the mach error for diagnostics
         // This commonly fails on __DATA_CONST in hardened runtimes
         return false;
     }
     return true;
 }
 
-static void rebind_section(struct rebinding *rebindings,
-                           size_t rebindings_nel,
-                           section_t *sect,
-                           intptr_t slide,
-                           nlist_t *symtab,
-                           size_t nsyms,
-                           char *strtab,
-                           size_t strtab_size,
-                           uint32_t *indirect_symtab) {
+// Patches matching slots in one pointer section and returns how many were patched.
+//
+// Protection is changed lazily, one page at a time, only once a slot on that page matches.
+// VM_PROT_COPY forces copy-on-write of the page, so sections that reference none of the
+// rebound symbols (most of every system framework) are never dirtied.
+static size_t rebind_section(const struct rebinding_table *table,
+                             section_t *sect,
+                             intptr_t slide,
+                             nlist_t *symtab,
+                             size_t nsyms,
+                             char *strtab,
+                             size_t strtab_size,
+                             uint32_t *indirect_symtab,
+                             size_t *pages_protected) {
     uint32_t *indirect_syms = indirect_symtab + sect->reserved1;
     void **indirect_bindings_base = (void **)((uintptr_t)slide + sect->addr);
-    
-    // Ensure we can patch pointers in this section (once per section)
-    if (!make_section_writable(indirect_bindings_base, (size_t)sect->size)) {
-        // Failed to make section writable (likely __DATA_CONST in hardened runtime)
-        // Skip this section to avoid SIGBUS when attempting to write
-        return;
-    }
+    uintptr_t current_page = 0;
+    bool current_page_writable = false;
+    size_t patched = 0;
     
     size_t count = (size_t)(sect->size / sizeof(void *));
     for (size_t i = 0; i < count; i++) {
@@ -92,40 +223,77 @@ static void rebind_section(struct rebinding *rebindings,
         size_t maxlen = strtab_size - (size_t)strx;
         if (maxlen == 0 || symname[0] != '_') continue;
         
-        for (size_t j = 0; j < rebindings_nel; j++) {
-            const char *target = rebindings[j].name;
-            if (!target) continue;
-            
-            size_t tlen = strlen(target);
-            if ((tlen + 1) <= maxlen && strncmp(symname + 1, target, tlen) == 0 && symname[1 + tlen] == '\0') {
-                void **slot = &indirect_bindings_base[i];
-                
-                if (rebindings[j].replaced && *rebindings[j].replaced == NULL) {
-#if defined(__arm64e__)
-                    // Strip ptrauth signature to get usable original function pointer
-                    *rebindings[j].replaced = ptrauth_strip(*slot, ptrauth_key_function_pointer);
-#else
-                    *rebindings[j].replaced = *slot;
-#endif
-                }
-#if defined(__arm64e__)
-                // Sign replacement pointer with ptrauth before storing on arm64e
-                *slot = ptrauth_sign_unauthenticated(rebindings[j].replacement, ptrauth_key_function_pointer, 0);
-#else
-                *slot = rebindings[j].replacement;
-#endif
-                goto next_symbol;
+        // Hash the name past the leading underscore, giving up as soon as it is longer than
+        // every target or runs off the end of the string table.
+        const char *name = symname + 1;
+        size_t available = maxlen - 1;
+        size_t len = 0;
+        uint32_t hash = NAME_HASH_SEED;
+        while (len < available && len <= table->max_name_len && name[len] != '\0') {
+            hash = name_hash_step(hash, (unsigned char)name[len]);
+            len++;
+        }
+        if (len > table->max_name_len || len == available) continue;
+        
+        for (size_t j = 0; j < table->nel; j++) {
+            const struct prepared_rebinding *entry = &table->entries[j];
+            if (entry->name_hash != hash || entry->name_len != len ||
+                memcmp(name, entry->rebinding.name, len) != 0) {
+                continue;
             }
+            void **slot = &indirect_bindings_base[i];
+            uintptr_t page = (uintptr_t)slot & ~(uintptr_t)vm_page_mask;
+            if (page != current_page) {
+                current_page = page;
+                current_page_writable = make_page_writable(page);
+                if (current_page_writable) (*pages_protected)++;
+            }
+            // Failed to make the page writable (likely __DATA_CONST in hardened runtime)
+            // Skip the slot to avoid SIGBUS when attempting to write
+            if (!current_page_writable) break;
+            
+            os_unfair_lock_lock(&g_lock);
+            bool applied = patch_slot_locked(table, entry, slot);
+            os_unfair_lock_unlock(&g_lock);
+            if (applied) patched++;
+            break;
+        }
+    }
+    return patched;
+}
+
+// Must hold g_lock. A rescan that patches nothing (the image was already rebound, e.g. by both
+// the dyld callback and rebind_symbols) keeps the earlier record.
+static void record_image_locked(const void *header, size_t patched, size_t pages_protected) {
+    struct image_record *record = NULL;
+    for (size_t i = 0; i < g_image_count; i++) {
+        if (g_images[i].header == header) {
+            record = &g_images[i];
+            break;
         }
-        next_symbol:;
     }
+    if (record && patched == 0) return;
+    if (!record) {
+        if (g_image_count == g_image_capacity) {
+            size_t capacity = g_image_capacity ? g_image_capacity * 2 : 16;
+            struct image_record *grown = (struct image_record *)realloc(g_images, capacity * sizeof(struct image_record));
+            if (!grown) return;
+            g_images = grown;
+            g_image_capacity = capacity;
+        }
+        record = &g_images[g_image_count++];
+        record->header = header;
+    }
+    record->stats = (struct rebind_image_stats){ patched, pages_protected };
 }
 
 static void rebind_image(const struct mach_header *header,
                          intptr_t slide,
-                         struct rebinding *rebindings,
-                         size_t rebindings_nel) {
-    if (!rebindings || rebindings_nel == 0) return;
+                         const struct rebinding_table *table) {
+    if (!table || table->nel == 0) return;
+    if (table->filter && !table->filter(header)) return;
+    size_t patched = 0;
+    size_t pages_protected = 0;
     
     segment_command_t *cur_seg = NULL;
     segment_command_t *linkedit = NULL;
@@ -165,41 +333,105 @@ static void rebind_image(const struct mach_header *header,
             for (unsigned int j = 0; j < cur_seg->nsects; j++) {
                 uint32_t type = sects[j].flags & SECTION_TYPE;
                 if (type == S_LAZY_SYMBOL_POINTERS || type == S_NON_LAZY_SYMBOL_POINTERS) {
-                    rebind_section(rebindings, rebindings_nel, &sects[j], slide,
-                                   symtab, symtab_cmd->nsyms,
-                                   strtab, strtab_size,
-                                   indirect_symtab);
+                    patched += rebind_section(table, &sects[j], slide,
+                                              symtab, symtab_cmd->nsyms,
+                                              strtab, strtab_size,
+                                              indirect_symtab,
+                                              &pages_protected);
                 }
             }
         }
     }
+    
+    os_unfair_lock_lock(&g_lock);
+    record_image_locked(header, patched, pages_protected);
+    os_unfair_lock_unlock(&g_lock);
+}
+
+bool rebind_image_links_library(const struct mach_header *header, const char *library_name) {
+    if (!header || !library_name) return false;
+    size_t name_len = strlen(library_name);
+    
+    uintptr_t cur = (uintptr_t)header + sizeof(mach_header_t);
+    for (unsigned int i = 0; i < header->ncmds; i++) {
+        const struct load_command *cmd = (const struct load_command *)cur;
+        switch (cmd->cmd) {
+            case LC_LOAD_DYLIB:
+            case LC_LOAD_WEAK_DYLIB:
+            case LC_REEXPORT_DYLIB:
+            case LC_LAZY_LOAD_DYLIB:
+            case LC_LOAD_UPWARD_DYLIB: {
+                const struct dylib_command *dylib = (const struct dylib_command *)cmd;
+                const char *path = (const char *)cmd + dylib->dylib.name.offset;
+                size_t path_len = strlen(path);
+                // Match the final path component so install-name prefixes don't matter
+                if (path_len >= name_len &&
+                    strcmp(path + path_len - name_len, library_name) == 0 &&
+                    (path_len == name_len || path[path_len - name_len - 1] == '/')) {
+                    return true;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        cur += cmd->cmdsize;
+    }
+    return false;
+}
+
+bool rebind_get_image_stats(const void *header, struct rebind_image_stats *stats) {
+    if (!header || !stats) return false;
+    bool found = false;
+    os_unfair_lock_lock(&g_lock);
+    for (size_t i = 0; i < g_image_count; i++) {
+        if (g_images[i].header == header) {
+            *stats = g_images[i].stats;
+            found = true;
+            break;
+        }
+    }
+    os_unfair_lock_unlock(&g_lock);
+    return found;
 }
 
 // dyld callback
 static void dyld_callback(const struct mach_header *h, intptr_t slide) {
+    // Registered permanently, so keep image loads cheap while nothing is bound
+    if (!atomic_load_explicit(&g_active, memory_order_acquire)) return;
+    
     os_unfair_lock_lock(&g_lock);
-    struct rebinding *local = g_rebindings;
-    size_t nel = g_rebindings_nel;
+    struct rebinding_table *local = g_table;
     os_unfair_lock_unlock(&g_lock);
     
-    if (local && nel) {
-        rebind_image(h, slide, local, nel);
+    if (local) {
+        rebind_image(h, slide, local);
     }
 }
 
 int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel) {
+    return rebind_symbols_filtered(rebindings, rebindings_nel, NULL);
+}
+
+int rebind_symbols_filtered(struct rebinding rebindings[], size_t rebindings_nel, rebind_image_filter filter) {
     if (!rebindings || rebindings_nel == 0) return 0;
     
-    // Copy table to heap so we don't depend on caller's lifetime
-    struct rebinding *copy = (struct rebinding *)malloc(rebindings_nel * sizeof(struct rebinding));
-    if (!copy) return -1;
-    memcpy(copy, rebindings, rebindings_nel * sizeof(struct rebinding));
+    // Copy table to heap so we don't depend on caller's lifetime, hashing names once up front
+    struct rebinding_table *table = make_table(rebindings, rebindings_nel, filter);
+    if (!table) return -1;
     
     os_unfair_lock_lock(&g_lock);
-    // Free previous (if any)
-    if (g_rebindings) free(g_rebindings);
-    g_rebindings = copy;
-    g_rebindings_nel = rebindings_nel;
+    if (tables_equal(g_table, table)) {
+        // Rebinding the same table again (e.g. after unbind_symbols); keep the existing copy
+        // so a dyld callback still holding it never sees it freed
+        free_table(table);
+        table = g_table;
+    } else {
+        // Free previous (if any)
+        free_table(g_table);
+        g_table = table;
+    }
+    atomic_store_explicit(&g_active, true, memory_order_release);
     os_unfair_lock_unlock(&g_lock);
     
     // Register once (idempotent: dyld allows multiple callbacks)
@@ -217,11 +449,24 @@ int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel) {
     for (uint32_t i = 0; i < count; i++) {
         rebind_image(_dyld_get_image_header(i),
                      _dyld_get_image_vmaddr_slide(i),
-                     copy, rebindings_nel);
+                     table);
     }
     return 0;
 }
 
+size_t unbind_symbols(void) {
+    os_unfair_lock_lock(&g_lock);
+    atomic_store_explicit(&g_active, false, memory_order_release);
+    // Pages holding patched slots were made writable when they were patched and stay that way
+    size_t restored = g_patched_count;
+    for (size_t i = 0; i < g_patched_count; i++) {
+        *g_patched[i].slot = g_patched[i].original;
+    }
+    g_patched_count = 0;
+    os_unfair_lock_unlock(&g_lock);
+    return restored;
+}
+
 #else
 // Non-Darwin platforms - provide stub implementations
 int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel) {
@@ -231,4 +476,27 @@ int rebind_symbols(struct rebinding rebindings[], size_t rebindings_nel) {
     return 0;
 }
 
+int rebind_symbols_filtered(struct rebinding rebindings[], size_t rebindings_nel, rebind_image_filter filter) {
+    (void)rebindings;
+    (void)rebindings_nel;
+    (void)filter;
+    return 0;
+}
+
+bool rebind_image_links_library(const struct mach_header *header, const char *library_name) {
+    (void)header;
+    (void)library_name;
+    return false;
+}
+
+bool rebind_get_image_stats(const void *header, struct rebind_image_stats *stats) {
+    (void)header;
+    (void)stats;
+    return false;
+}
+
+size_t unbind_symbols(void) {
+    return 0;
+}
+
 #endif // __APPLE__ || __MACH__
@@ -0,0 +1,134 @@
+import Testing
+import DependencyGraph
+
+struct DependencyGraphTests {
+    @Test func factoriesDependOnReferencedFactoriesAndInjectedPropertiesOfWhatTheyConstruct() throws {
+        let graph = DependencyGraph(sources: [
+            (path: "Container+Services.swift", text: """
+            extension Container {
+                static let database = Factory(scope: .cached) { Database() }
+                static let logger = Factory { Logger() }
+                static let repository = Factory(scope: .cached) { Repository(database: database(), logger: Container.logger()) }
+                static let service = Factory(scope: .cached) { Service() }
+            }
+            """),
+            (path: "Service.swift", text: """
+            struct Service {
+                @ConstructorInjected(Container.repository) var repository: Repository
+                @Injected(Container.logger) var logger: Logger
+            }
+            """),
+        ])
+
+        #expect(graph.factories.map(\.id) == ["Container.database", "Container.logger", "Container.repository", "Container.service"])
+        #expect(graph.factories.map(\.scope) == ["cached", "unique", "cached", "cached"])
+        let dependencies = graph.factories.map { $0.dependencies.map { "\($0.kind): \($0.factory)" } }
+        #expect(dependencies == [
+            [],
+            [],
+            ["construction: Container.database", "construction: Container.logger"],
+            ["access: Container.logger", "construction: Container.repository"],
+        ])
+        #expect(graph.cycles.isEmpty)
+        #expect(graph.waves == [["Container.database", "Container.logger"], ["Container.repository"], ["Container.service"]])
+    }
+
+    @Test func onlyConstructionDependenciesFormCycles() throws {
+        let graph = DependencyGraph(sources: [
+            (path: "Services.swift", text: """
+            enum Services {
+                static let a = Factory(scope: .cached) { A(b: b()) }
+                static let b = Factory { B(c: Self.c()) }
+                static let c = Factory { C(a: Services.a()) }
+                static let dependsOnCycle = Factory { Consumer(a: a()) }
+                static let recursive = Factory { recursive() }
+                static let injectsItself = Factory { InjectsItself() }
+            }
+
+            final class InjectsItself {
+                @LazyInjected(Services.injectsItself) var me: InjectsItself
+            }
+            """),
+        ])
+
+        #expect(graph.cycles == [["Services.a", "Services.b", "Services.c"], ["Services.recursive"]])
+        #expect(graph.waves == [["Services.injectsItself"]])
+    }
+
+    @Test func namesBoundOrNotCalledInAResolverAreNotDependencies() throws {
+        let graph = DependencyGraph(sources: [
+            (path: "Container+Services.swift", text: """
+            extension Container {
+                static let logger = Factory { let logger = Logger(); return logger }
+                static let database = Factory { () -> Database in
+                    let logger = { Logger() }
+                    return Database(logger: logger())
+                }
+                static let cache = Factory { [database] in Cache(size: database.count) }
+                static let session = Factory { Session(database: database()) }
+            }
+            """),
+        ])
+
+        #expect(graph.cycles.isEmpty)
+        let dependencies = graph.factories.map { $0.dependencies.map(\.factory) }
+        #expect(graph.factories.map(\.id) == ["Container.cache", "Container.database", "Container.logger", "Container.session"])
+        #expect(dependencies == [[], [], [], ["Container.database"]])
+    }
+
+    @Test func factoriesInsidePrivateTypesAreNotAccessible() throws {
+        let graph = DependencyGraph(sources: [
+            (path: "Factories.swift", text: """
+            private enum Factories {
+                static let hidden = Factory(scope: .cached) { Service() }
+            }
+            fileprivate extension Container {
+                static let alsoHidden = Factory(scope: .cached) { Service() }
+            }
+            enum Outer {
+                private enum Inner {
+                    static let nested = Factory(scope: .cached) { Service() }
+                }
+                static let visible = Factory(scope: .cached) { Service() }
+            }
+            """),
+        ])
+
+        #expect(graph.factories.map(\.id) == ["Container.alsoHidden", "Factories.hidden", "Outer.Inner.nested", "Outer.visible"])
+        #expect(graph.factories.map(\.isAccessible) == [false, false, false, true])
+        #expect(graph.prewarmSource.contains("[Outer.visible],"))
+        #expect(!graph.prewarmSource.contains("hidden"))
+        #expect(!graph.prewarmSource.contains("Hidden"))
+        #expect(!graph.prewarmSource.contains("nested"))
+    }
+
+    @Test func prewarmSourceListsAccessibleCachedFactoriesByWave() throws {
+        let graph = DependencyGraph(sources: [
+            (path: "Container+Services.swift", text: """
+            extension Container {
+                static let database = Factory(scope: .cached) { Database() }
+                private static let secret = Factory(scope: .cached) { Secret() }
+                static let session = Factory(scope: .shared) { Session(database: database()) }
+                static let cache = Factory(scope: .cached(ttl: .seconds(5))) { Cache(database: database()) }
+            }
+            """),
+        ])
+
+        #expect(graph.waves == [["Container.database", "Container.secret"], ["Container.cache", "Container.session"]])
+        #expect(graph.prewarmSource == """
+        // Generated by DependencyGraphPlugin from this module's factories. Do not edit.
+
+        import DependencyInjection
+
+        extension Container {
+            /// This module's cached factories in construction order: every factory's construction
+            /// dependencies are in an earlier wave.
+            static let prewarmWaves: [[any Prewarmable]] = [
+                [Container.database],
+                [Container.cache],
+            ]
+        }
+
+        """)
+    }
+}
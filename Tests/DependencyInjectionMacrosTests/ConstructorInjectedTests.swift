@@ -304,4 +304,126 @@ struct ConstructorInjectedTests {
             """
         }
     }
+    
+    @Test(
+        .macros(
+          [
+            "ConstructorInjection": ConstructorInjectionMacro.self,
+            "ConstructorInjected": ConstructorInjectedSyncMacro.self,
+          ],
+          record: .never // Record only missing snapshots
+        )
+    )
+    func macroBatchesConstructorInjectedProperties() {
+        assertMacro {
+            """
+            class Dependency { }
+            extension Container {
+                static let dependency = Factory { Dependency() }
+            }
+            
+            @ConstructorInjection
+            public class Example {
+                @ConstructorInjected(Container.dependency, batched: true) private var dependency: Dependency
+            }
+            """
+        } expansion: {
+            """
+            class Dependency { }
+            extension Container {
+                static let dependency = Factory { Dependency() }
+            }
+            public class Example {
+                private var dependency: Dependency {
+                    get {
+                        _constructorInjection.dependency.wrappedValue
+                    }
+                }
+
+                private typealias _dependency = SyncFactory<Dependency>
+
+                private var $dependency: SyncFactory<Dependency> {
+                    _constructorInjection.dependency.projectedValue
+                }
+
+                private struct _ConstructorInjection {
+                    let dependency: ConstructorInjectedResolver<Dependency, _dependency>
+
+                    init(file: String, line: UInt, function: String) {
+                        dependency = BoundResolver.withCurrent { resolve in
+                            ConstructorInjectedResolver(Container.dependency, resolvingWith: resolve, file: file, line: line, function: function)
+                        }
+                    }
+                }
+
+                private let _constructorInjection = _ConstructorInjection(file: #file, line: #line, function: #function)
+            }
+            """
+        }
+    }
+
+    @Test(
+        .macros(
+          [
+            "ConstructorInjection": ConstructorInjectionMacro.self,
+            "ConstructorInjected": ConstructorInjectedSyncMacro.self,
+          ],
+          record: .never // Record only missing snapshots
+        )
+    )
+    func macroResolvesEveryBatchedPropertyThroughOneBinding() {
+        assertMacro {
+            """
+            @ConstructorInjection
+            final class Example {
+                @ConstructorInjected(Container.logger, batched: true) private var logger: Logger
+                @ConstructorInjected(Container.session, batched: true) private var session: Session
+            }
+            """
+        } expansion: {
+            """
+            final class Example {
+                private var logger: Logger {
+                    get {
+                        _constructorInjection.logger.wrappedValue
+                    }
+                }
+
+                private typealias _logger = SyncFactory<Logger>
+
+                private var $logger: SyncFactory<Logger> {
+                    _constructorInjection.logger.projectedValue
+                }
+
+                private var session: Session {
+                    get {
+                        _constructorInjection.session.wrappedValue
+                    }
+                }
+
+                private typealias _session = SyncFactory<Session>
+
+                private var $session: SyncFactory<Session> {
+                    _constructorInjection.session.projectedValue
+                }
+
+                private struct _ConstructorInjection {
+                    let logger: ConstructorInjectedResolver<Logger, _logger>
+                    let session: ConstructorInjectedResolver<Session, _session>
+
+                    init(file: String, line: UInt, function: String) {
+                        (logger, session) = BoundResolver.withCurrent { resolve in
+                            (
+                                ConstructorInjectedResolver(Container.logger, resolvingWith: resolve, file: file, line: line, function: function),
+                                ConstructorInjectedResolver(Container.session, resolvingWith: resolve, file: file, line: line, function: function)
+                            )
+                        }
+                    }
+                }
+
+                private let _constructorInjection = _ConstructorInjection(file: #file, line: #line, function: #function)
+            }
+            """
+        }
+    }
 }
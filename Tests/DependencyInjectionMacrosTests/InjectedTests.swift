@@ -304,4 +304,46 @@ struct InjectedTests {
             """
         }
     }
+    
+    @Test(
+        .macros(
+          ["Injected": InjectedSyncMacro.self],
+          record: .never // Record only missing snapshots
+        )
+    )
+    func macroForwardsMemoized() {
+        assertMacro {
+            """
+            class Dependency { }
+            extension Container {
+                static let dependency = Factory(scope: .cached) { Dependency() }
+            }
+            
+            public class Example {
+                @Injected(Container.dependency, memoized: true) private var dependency: Dependency
+            }
+            """
+        } expansion: {
+            """
+            class Dependency { }
+            extension Container {
+                static let dependency = Factory(scope: .cached) { Dependency() }
+            }
+
+            public class Example {
+                private var dependency: Dependency {
+                    get {
+                        _dependency.wrappedValue
+                    }
+                }
+
+                private  let _dependency = InjectedResolver(Container.dependency, memoized: true, file: #file, line: #line, function: #function)
+
+                private var $dependency: SyncFactory<Dependency> {
+                    _dependency.projectedValue
+                }
+            }
+            """
+        }
+    }
 }
@@ -137,6 +137,48 @@ struct LazyInjectedTests {
         }
     }
     
+    @Test(
+        .macros(
+          ["LazyInjected": LazyInjectedAsyncMacro.self],
+          record: .never // Record only missing snapshots
+        )
+    )
+    func macroForwardsStartsOnFirstAccess() {
+        assertMacro {
+            """
+            class Dependency { }
+            extension Container {
+                static let dependency = Factory { Dependency() }
+            }
+            
+            public class Example {
+                @LazyInjected(Container.dependency, startsOnFirstAccess: true) private var dependency: Task<Dependency, Never>
+            }
+            """
+        } expansion: {
+            """
+            class Dependency { }
+            extension Container {
+                static let dependency = Factory { Dependency() }
+            }
+            
+            public class Example {
+                private var dependency: Task<Dependency, Never> {
+                    get {
+                        _dependency.wrappedValue
+                    }
+                }
+            
+                private  let _dependency = LazyInjectedResolver(Container.dependency, startsOnFirstAccess: true, file: #file, line: #line, function: #function)
+            
+                private var $dependency: AsyncFactory<Dependency> {
+                    _dependency.projectedValue
+                }
+            }
+            """
+        }
+    }
+    
     @Test(
         .macros(
           ["LazyInjected": LazyInjectedAsyncThrowingMacro.self],
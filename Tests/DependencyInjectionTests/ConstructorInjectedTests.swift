@@ -10,6 +10,61 @@ import DependencyInjection
 import Atomics
 
 struct ConstructorInjectedTests {
+    @Test func constructorInjection_WithBatchedProperties_ResolvesEveryKindOnceAtInit() async throws {
+        @ConstructorInjection
+        final class Example {
+            @ConstructorInjected(Container.exampleDependency, batched: true) var dependency: ExampleDependency
+            @ConstructorInjected(Container.exampleThrowingDependency, batched: true) var throwingDependency: Result<ExampleThrowingDependency, any Error>
+            @ConstructorInjected(Container.exampleAsyncDependency, batched: true) var asyncDependency: Task<ExampleAsyncDependency, Never>
+            @ConstructorInjected(Container.exampleAsyncThrowingDependency, batched: true) var asyncThrowingDependency: Task<ExampleAsyncThrowingDependency, any Error>
+            @ConstructorInjected(Container.exampleDependency) var unbatched: ExampleDependency
+        }
+
+        try await withTestContainer {
+            let expected = ExampleDependency()
+            let expectedThrowing = try ExampleThrowingDependency()
+            let expectedAsync = await ExampleAsyncDependency()
+            let expectedAsyncThrowing = try await ExampleAsyncThrowingDependency()
+            let count = ManagedAtomic(0)
+            Container.exampleDependency.register {
+                count.wrappingIncrement(ordering: .sequentiallyConsistent)
+                return expected
+            }
+            Container.exampleThrowingDependency.register { expectedThrowing }
+            Container.exampleAsyncDependency.register { expectedAsync }
+            Container.exampleAsyncThrowingDependency.register { expectedAsyncThrowing }
+
+            let example = Example()
+            #expect(example.dependency === expected)
+            #expect(example.unbatched === expected)
+            #expect(try example.throwingDependency.get() === expectedThrowing)
+            #expect(await example.asyncDependency.value === expectedAsync)
+            #expect(try await example.asyncThrowingDependency.value === expectedAsyncThrowing)
+            #expect(example.$dependency === Container.exampleDependency)
+            #expect(count.load(ordering: .sequentiallyConsistent) == 2)
+        }
+    }
+
+    @Test func constructorInjection_WithBatchedProperties_TakesTheFactoryKindFromTheFactory() async throws {
+        @ConstructorInjection
+        final class Example {
+            @ConstructorInjected(Container.exampleResult, batched: true) var result: Result<ExampleDependency, any Error>
+            @ConstructorInjected(Container.exampleAsyncDependency, batched: true) var asyncDependency: Swift.Task<ExampleAsyncDependency, Swift.Never>
+        }
+
+        await withTestContainer {
+            let expected = ExampleDependency()
+            let expectedAsync = await ExampleAsyncDependency()
+            Container.exampleResult.register { .success(expected) }
+            Container.exampleAsyncDependency.register { expectedAsync }
+
+            let example = Example()
+            #expect(try example.result.get() === expected)
+            #expect(await example.asyncDependency.value === expectedAsync)
+            #expect(example.$result === Container.exampleResult)
+        }
+    }
+
     @Test func constructorInjectedPropertyWrapper_WithSyncFactory_ResolvesEveryTime() async throws {
         class Example {
             @ConstructorInjected(Container.exampleDependency) var dependency: ExampleDependency
@@ -111,3 +166,7 @@ struct ConstructorInjectedTests {
         }
     }
 }
+
+extension Container {
+    fileprivate static let exampleResult = Factory { Result<ExampleDependency, any Error>.success(ExampleDependency()) }
+}
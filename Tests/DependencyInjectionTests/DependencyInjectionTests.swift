@@ -1,6 +1,8 @@
 import Foundation
 import Testing
-import DependencyInjection
+@testable import DependencyInjection
+import Atomics
+import ServiceContextModule
 
 struct DependencyInjectionTests {
     @Test func synchronousFactoryCanResolveAUniqueType() async throws {
@@ -312,6 +314,455 @@ struct DependencyInjectionTests {
         }
     }
     
+    @Test func deeplyNestedContainersSeeAncestorRegistrationChanges() async throws {
+        withNestedContainer {
+            let factory = Factory { 0 }
+            factory.register { 1 }
+            let root = Container.current
+
+            withNestedContainer {
+                withNestedContainer {
+                    withNestedContainer {
+                        #expect(factory() == 1)
+                        #expect(factory() == 1)
+
+                        withContainer(root) { factory.register { 2 } }
+                        #expect(factory() == 2)
+
+                        withContainer(root) {
+                            factory.popRegistration()
+                            factory.popRegistration()
+                        }
+                        #expect(factory() == 0)
+                    }
+                }
+            }
+        }
+    }
+    
+    @Test func nestedContainersSeeRegistrationChangesAnywhereInTheirHierarchy() async throws {
+        withNestedContainer {
+            let factory = Factory { 0 }
+            let outer = Container.current
+
+            withNestedContainer {
+                let middle = Container.current
+                withNestedContainer {
+                    #expect(factory() == 0)
+                    withContainer(middle) { factory.register { 1 } }
+                    #expect(factory() == 1)
+                }
+            }
+
+            // Recycled containers join the hierarchy of whichever parent takes them next.
+            withNestedContainer {
+                withNestedContainer {
+                    #expect(factory() == 0)
+                    withContainer(outer) { factory.register { 2 } }
+                    #expect(factory() == 2)
+                }
+            }
+        }
+    }
+
+    @Test func resolutionInstrumentationReportsCountsCacheOutcomesAndDepth() async throws {
+        let metrics = ResolutionMetrics()
+        ResolutionInstrumentation.install(metrics)
+        defer { ResolutionInstrumentation.uninstall() }
+
+        withNestedContainer {
+            let unique = Factory { 0 }
+            let cached = Factory(scope: .cached) { 0 }
+            unique.register { 1 }
+
+            withNestedContainer {
+                withNestedContainer {
+                    #expect(unique() == 1)
+                    #expect(unique() == 1)
+                }
+            }
+            #expect(cached() == 0)
+            #expect(cached() == 0)
+
+            let uniqueMetrics = try? #require(metrics.metrics(for: unique))
+            #expect(uniqueMetrics?.resolutions == 2)
+            #expect(uniqueMetrics?.cacheHitRate == nil)
+            #expect(uniqueMetrics?.maxDepth == 2)
+
+            let cachedMetrics = try? #require(metrics.metrics(for: cached))
+            #expect(cachedMetrics?.resolutions == 2)
+            #expect(cachedMetrics?.cacheMisses == 1)
+            #expect(cachedMetrics?.cacheHits == 1)
+        }
+    }
+
+    @Test func lockDiagnosticsAttributeAcquisitionsToSitesAndFactories() async throws {
+        try withNestedContainer {
+            let cached = Factory(scope: .cached) { 0 }
+            #expect(cached() == 0)
+
+            // CI also runs the suite with `DI_LOCK_DIAGNOSTICS=1`, which takes the first branch.
+            let snapshot = LockDiagnostics.snapshot()
+            if LockDiagnostics.isEnabled {
+                let statistics = try #require(snapshot.statistics(for: cached))
+                #expect(statistics.acquisitions > 0)
+                let strongCache = try #require(snapshot.sites["StrongCache"])
+                #expect(strongCache.acquisitions > 0)
+            } else {
+                #expect(snapshot.sites.isEmpty)
+                #expect(snapshot.factories.isEmpty)
+            }
+        }
+    }
+
+    @Test func boundResolverResolvesInItsCapturedContainer() async throws {
+        final class Service: Sendable { }
+        await withNestedContainer {
+            let unique = Factory { 0 }
+            let cached = Factory(scope: .cached) { Service() }
+
+            let (resolve, cachedInContainer) = withNestedContainer {
+                unique.register { 1 }
+                return (BoundResolver(), cached())
+            }
+
+            #expect(unique() == 0)
+            #expect(resolve(unique) == 1)
+            #expect(resolve(cached) === cachedInContainer)
+            #expect(cached() !== cachedInContainer)
+            #expect(await Task.detached { resolve(unique) }.value == 1)
+        }
+    }
+
+    @Test func boundResolverResolvesNestedDependenciesInItsContainer() async throws {
+        withNestedContainer {
+            let inner = Factory { 0 }
+            let outer = Factory { inner() }
+
+            let resolve = withNestedContainer {
+                inner.register { 1 }
+                return BoundResolver()
+            }
+
+            #expect(outer() == 0)
+            #expect(resolve(outer) == 1)
+            #expect(resolve.withBinding { resolve in (resolve(outer), inner()) } == (1, 1))
+            #expect(resolve.resolve(outer, inner) == (1, 1))
+        }
+    }
+
+    @Test func batchResolutionReturnsEveryDependencyInOrder() async throws {
+        withNestedContainer {
+            let number = Factory { 1 }
+            let text = Factory { "one" }
+            number.register { 2 }
+
+            let (resolvedNumber, resolvedText) = Container.resolve(number, text)
+            #expect(resolvedNumber == 2)
+            #expect(resolvedText == "one")
+
+            let failing = Factory { () throws -> Int in throw ResolutionFailure() }
+            #expect(throws: ResolutionFailure.self) { _ = try Container.resolve(Factory { () throws in 1 }, failing) }
+        }
+    }
+
+    @Test func asyncBatchResolutionRunsResolversConcurrently() async throws {
+        await withNestedContainer {
+            // Each resolver waits for the other to start, so this only completes if they overlap.
+            let first = AsyncStream<Void>.makeStream()
+            let second = AsyncStream<Void>.makeStream()
+            let a = Factory { () async in
+                first.continuation.yield()
+                for await _ in second.stream { break }
+                return "a"
+            }
+            let b = Factory { () async in
+                second.continuation.yield()
+                for await _ in first.stream { break }
+                return 1
+            }
+
+            let (resolvedA, resolvedB) = await Container.resolve(a, b)
+            #expect(resolvedA == "a")
+            #expect(resolvedB == 1)
+        }
+    }
+
+    @Test func prewarmPopulatesCachedFactoriesOnce() async throws {
+        await withNestedContainer {
+            let constructions = ManagedAtomic(0)
+            let syncCached = Factory(scope: .cached) { constructions.wrappingIncrement(ordering: .relaxed); return 1 }
+            let asyncCached = Factory(scope: .cached) { () async in constructions.wrappingIncrement(ordering: .relaxed); return 2 }
+            let unique = Factory { constructions.wrappingIncrement(ordering: .relaxed); return 3 }
+
+            async let racingResolution = asyncCached()
+            await Container.prewarm([syncCached, asyncCached, unique])
+            #expect(constructions.load(ordering: .relaxed) == 2)
+
+            #expect(syncCached() == 1)
+            #expect(await asyncCached() == 2)
+            #expect(await racingResolution == 2)
+            #expect(constructions.load(ordering: .relaxed) == 2)
+        }
+    }
+
+    @Test func prewarmCachedFactoriesOnlyKnowsStaticFactoriesThatWereAccessed() async throws {
+        // Nothing has touched `Container.unaccessedCachedProbe`, as in a fresh process where no
+        // `static let` factory has been accessed yet, so there is nothing for a launch-time
+        // `prewarmCachedFactories()` to warm.
+        let isProbe: (any Prewarmable) -> Bool = { $0 is SyncFactory<UnaccessedCachedProbe> }
+        #expect(!CachedFactories.all().contains(where: isProbe))
+
+        _ = Container.unaccessedCachedProbe
+        #expect(CachedFactories.all().contains(where: isProbe))
+    }
+
+    @Test func expiringCachedScopeResolvesAgainOnceTheTTLElapses() async throws {
+        final class Service: Sendable { }
+        try await withNestedContainer {
+            let factory = Factory(scope: .cached(ttl: .milliseconds(200))) { Service() }
+            let first = factory()
+            #expect(factory() === first)
+            try await Task.sleep(for: .milliseconds(300))
+            let second = factory()
+            #expect(second !== first)
+            #expect(factory() === second)
+        }
+    }
+
+    @Test func capacityBoundCachedScopeEvictsTheLeastRecentlyUsedContainer() async throws {
+        final class Service: Sendable { }
+        withNestedContainer {
+            let factory = Factory(scope: .cached(capacity: 2)) { Service() }
+            let (a, b, c) = (withNestedContainer { Container.current },
+                             withNestedContainer { Container.current },
+                             withNestedContainer { Container.current })
+
+            let inA = withContainer(a) { factory() }
+            let inB = withContainer(b) { factory() }
+            #expect(withContainer(a) { factory() } === inA)
+            _ = withContainer(c) { factory() }
+
+            #expect(withContainer(a) { factory() } === inA)
+            #expect(withContainer(b) { factory() } !== inB)
+        }
+    }
+
+    @Test func capacityBoundCachedScopeKeepsANewEntryWhenEveryResidentOneIsHot() async throws {
+        final class Service: Sendable { }
+        withNestedContainer {
+            let resolutions = ManagedAtomic(0)
+            let factory = Factory(scope: .cached(capacity: 2)) {
+                resolutions.wrappingIncrement(ordering: .relaxed)
+                return Service()
+            }
+            let (a, b, c) = (withNestedContainer { Container.current },
+                             withNestedContainer { Container.current },
+                             withNestedContainer { Container.current })
+
+            let inA = withContainer(a) { factory() }
+            _ = withContainer(b) { factory() }
+            #expect(withContainer(a) { factory() } === inA)
+            _ = withContainer(b) { factory() }
+
+            let inC = withContainer(c) { factory() }
+            #expect(withContainer(c) { factory() } === inC)
+            #expect(resolutions.load(ordering: .relaxed) == 3)
+        }
+    }
+
+    @Test func containersResolveOverridesWhetherTheyAreSparseOrDense() async throws {
+        let factories = (0..<200).map { index in Factory { index } }
+        withNestedContainer {
+            factories[0].register { -1 }
+            factories[199].register { -2 }
+            #expect(factories[0]() == -1)
+            #expect(factories[199]() == -2)
+            #expect(factories[100]() == 100)
+
+            factories[199].popRegistration()
+            #expect(factories[199]() == 199)
+
+            for factory in factories {
+                factory.register { 0 }
+            }
+            #expect(factories.allSatisfy { $0() == 0 })
+
+            for factory in factories.dropFirst() {
+                factory.popRegistration()
+            }
+            #expect(factories[0]() == 0)
+            #expect(factories[199]() == 199)
+        }
+    }
+
+    @Test func scopesSharedByFactoriesOfDifferentTypesNeverServeTheWrongType() async throws {
+        final class Service: Sendable { }
+        withNestedContainer {
+            let cached = Scope.cached
+            let number = Factory(scope: cached) { 1 }
+            let text = Factory(scope: cached) { "one" }
+            #expect(number() == 1)
+            #expect(text() == "one")
+            #expect(number() == 1)
+
+            let shared = Scope.shared
+            let service = Factory(scope: shared) { Service() }
+            let object = Factory(scope: shared) { Service() as AnyObject }
+            let resolved = service()
+            #expect(service() === resolved)
+            #expect(object() !== resolved)
+        }
+    }
+
+    @Test func recycledNestedContainersStartEmptyAndEscapedOnesAreKept() async throws {
+        final class Service: Sendable { }
+        withNestedContainer {
+            let unique = Factory { 0 }
+            let cached = Factory(scope: .cached) { Service() }
+
+            let firstCached = withNestedContainer {
+                unique.register { 1 }
+                return cached()
+            }
+            withNestedContainer {
+                #expect(unique() == 0)
+                #expect(cached() !== firstCached)
+            }
+
+            let escaped = withNestedContainer {
+                unique.register { 2 }
+                return Container.current
+            }
+            withNestedContainer {
+                #expect(Container.current !== escaped)
+                #expect(unique() == 0)
+            }
+            #expect(withContainer(escaped) { unique() } == 2)
+        }
+    }
+
+    @Test func containerPoolReusesUnreferencedContainersUpToItsCapacity() async throws {
+        let pool = ContainerPool(capacity: 1)
+        let parent = Container.current
+        var first = pool.take(parent: parent)
+        var second = pool.take(parent: parent)
+        let firstID = ObjectIdentifier(first)
+        pool.recycle(&first)
+        pool.recycle(&second)
+
+        var reused = pool.take(parent: parent)
+        #expect(ObjectIdentifier(reused) == firstID)
+        #expect(reused.parent === parent)
+        #expect(pool.take(parent: parent) !== second)
+
+        let escaped = reused
+        pool.recycle(&reused)
+        #expect(pool.take(parent: parent) !== escaped)
+    }
+
+    @Test func requestScopeCachesPerRequestAndReleasesEverythingWhenTheRequestEnds() async throws {
+        final class Service: Sendable { }
+        try await withNestedContainer {
+            let sync = Factory(scope: .request) { Service() }
+            let asyncFactory = Factory(scope: .request) { () async in Service() }
+            let throwingFactory = Factory(scope: .request) { () async throws in Service() }
+
+            weak var released: Service?
+            try await withRequestScope {
+                let first = sync()
+                released = first
+                #expect(sync() === first)
+                withRequestScope {
+                    #expect(sync() !== first)
+                }
+
+                async let a = asyncFactory()
+                async let b = asyncFactory()
+                let (resolvedA, resolvedB) = await (a, b)
+                #expect(resolvedA === resolvedB)
+                #expect(try await throwingFactory() === throwingFactory())
+
+                sync.register { Service() }
+                #expect(sync() !== first)
+            }
+            #expect(released == nil)
+            #expect(sync() !== sync())
+        }
+    }
+
+    @Test func slowRequestScopedResolutionsInOneRequestDoNotWaitOnEachOther() throws {
+        final class Service: Sendable { }
+        let started = DispatchSemaphore(value: 0)
+        let release = DispatchSemaphore(value: 0)
+        let first = Factory(scope: .request) {
+            started.signal()
+            _ = release.wait(timeout: .now() + 5)
+            return Service()
+        }
+        let second = Factory(scope: .request) {
+            started.signal()
+            _ = release.wait(timeout: .now() + 5)
+            return Service()
+        }
+
+        try withNestedContainer {
+            try withRequestScope {
+                let context = try #require(ServiceContext.current)
+                let resolutions = DispatchGroup()
+                let firstResolved = ManagedAtomicLazyReference<Service>()
+                let secondResolved = ManagedAtomicLazyReference<Service>()
+                DispatchQueue.global().async(group: resolutions) {
+                    _ = firstResolved.storeIfNilThenLoad(ServiceContext.withValue(context) { first() })
+                }
+                DispatchQueue.global().async(group: resolutions) {
+                    _ = secondResolved.storeIfNilThenLoad(ServiceContext.withValue(context) { second() })
+                }
+
+                // Both resolvers are running at once, so neither waits behind the other's construction.
+                #expect(started.wait(timeout: .now() + 1) == .success)
+                #expect(started.wait(timeout: .now() + 1) == .success)
+                release.signal()
+                release.signal()
+                #expect(resolutions.wait(timeout: .now() + 5) == .success)
+
+                #expect(firstResolved.load() === first())
+                #expect(secondResolved.load() === second())
+            }
+        }
+    }
+
+    @Test func registrationsArePublishedToConcurrentReaders() async throws {
+        await withNestedContainer {
+            let factory = Factory { 0 }
+
+            await withTaskGroup(of: Void.self) { group in
+                for i in 1...100 {
+                    group.addTask { factory.register { i } }
+                    group.addTask { _ = factory() }
+                }
+            }
+
+            #expect(factory() != 0)
+            for _ in 1...100 {
+                factory.popRegistration()
+            }
+            #expect(factory() == 0)
+        }
+    }
+    
+    @Test func manyFactoriesKeepIndependentRegistrations() async throws {
+        withNestedContainer {
+            let factories = (0..<500).map { i in Factory { i } }
+
+            for (i, factory) in factories.enumerated().reversed() {
+                factory.register { i * 2 }
+            }
+
+            #expect(factories.enumerated().allSatisfy { i, factory in factory() == i * 2 })
+        }
+    }
+    
     @Test func synchronousFactoryCanResolveWithACachedScope() async throws {
         withNestedContainer {
             class Super { }
@@ -321,6 +772,33 @@ struct DependencyInjectionTests {
         }
     }
     
+    @Test func cachedScopeServesParentValueToNestedContainers() async throws {
+        withNestedContainer {
+            class Super { }
+            let factory = Factory(scope: .cached) { Super() }
+            let parentValue = factory()
+
+            withNestedContainer {
+                #expect(factory() === parentValue)
+                #expect(factory() === parentValue)
+            }
+        }
+    }
+    
+    @Test func cachedValuesAreReleasedWithTheirNestedContainer() async throws {
+        class Super { }
+        let factory = Factory(scope: .cached) { Super() }
+        weak var cached: Super?
+
+        withNestedContainer {
+            let resolved = factory()
+            cached = resolved
+            #expect(factory() === resolved)
+        }
+
+        #expect(cached == nil)
+    }
+    
     @Test func synchronousThrowingFactoryCanResolveWithACachedScope() async throws {
         try withNestedContainer {
             class Super {
@@ -374,6 +852,35 @@ struct DependencyInjectionTests {
         }
     }
     
+    @Test func asynchronousFactoryDeduplicatesConcurrentCachedResolutions() async throws {
+        await withNestedContainer {
+            actor Counter {
+                var count = 0
+                func increment() {
+                    count += 1
+                }
+            }
+            final class Super: Sendable { }
+            let counter = Counter()
+            let factory = Factory(scope: .cached) { () async -> Super in
+                await counter.increment()
+                try? await Task.sleep(nanoseconds: 1_000_000)
+                return Super()
+            }
+
+            let resolved = await withTaskGroup(of: Super.self) { group in
+                for _ in 0..<50 {
+                    group.addTask { await factory() }
+                }
+                return await group.reduce(into: [Super]()) { $0.append($1) }
+            }
+
+            #expect(resolved.allSatisfy { $0 === resolved[0] })
+            let count = await counter.count
+            #expect(count == 1)
+        }
+    }
+    
     @Test func asynchronousThrowingFactoryCanResolveInParallelWithACachedScope() async throws {
         try await withNestedContainer {
             actor Super {
@@ -691,6 +1198,75 @@ struct DependencyInjectionTests {
             #expect(first !== third)
         }
     }
+
+    @Test func slowCachedResolutionOnlyBlocksCallersInTheSameContainer() throws {
+        final class Super: @unchecked Sendable { }
+        let factory = Factory(scope: .cached) { Super() }
+        let started = DispatchSemaphore(value: 0)
+        let release = DispatchSemaphore(value: 0)
+        let slowContainer = withNestedContainer {
+            factory.register {
+                started.signal()
+                _ = release.wait(timeout: .now() + 5)
+                return Super()
+            }
+            return Container.current
+        }
+        let otherContainer = withNestedContainer { Container.current }
+        let slowResolutions = DispatchGroup()
+        let resolved = ManagedAtomic(0)
+
+        for _ in 0..<2 {
+            DispatchQueue.global().async(group: slowResolutions) {
+                _ = withContainer(slowContainer) { factory() }
+                resolved.wrappingIncrement(ordering: .relaxed)
+            }
+        }
+        #expect(started.wait(timeout: .now() + 1) == .success)
+
+        // Another container resolves the same factory while the slow one is still running.
+        let otherResolved = DispatchSemaphore(value: 0)
+        DispatchQueue.global().async {
+            _ = withContainer(otherContainer) { factory() }
+            otherResolved.signal()
+        }
+        #expect(otherResolved.wait(timeout: .now() + 1) == .success)
+        #expect(resolved.load(ordering: .relaxed) == 0)
+
+        release.signal()
+        #expect(slowResolutions.wait(timeout: .now() + 1) == .success)
+        // The second caller waited for the first instead of running the resolver again.
+        #expect(started.wait(timeout: .now()) == .timedOut)
+        #expect(withContainer(slowContainer) { factory() } === withContainer(slowContainer) { factory() })
+    }
+
+    @Test func cachedResolverCanReenterItsOwnFactory() async throws {
+        class Super { }
+        enum Globals {
+            nonisolated(unsafe) static var reentered = false
+            static let service = Factory(scope: .cached) { () -> Super in
+                if !reentered {
+                    reentered = true
+                    _ = service()
+                }
+                return Super()
+            }
+        }
+
+        withNestedContainer {
+            let first = Globals.service()
+            #expect(Globals.reentered)
+            #expect(Globals.service() === first)
+        }
+    }
+}
+
+private struct ResolutionFailure: Error { }
+
+private struct UnaccessedCachedProbe { }
+
+extension Container {
+    fileprivate static let unaccessedCachedProbe = Factory(scope: .cached) { UnaccessedCachedProbe() }
 }
 
 extension DispatchSemaphore {
@@ -119,6 +119,55 @@ struct InjectedPropertyWrapperTests {
             #expect(count.load(ordering: .sequentiallyConsistent) == 2)
         }
     }
+
+    @Test func injectedPropertyWrapper_WhenMemoized_ResolvesOnceUntilRegistrationsOrCachesChange() async throws {
+        class Example {
+            @Injected(Container.cachedExampleDependency, memoized: true) var dependency: ExampleDependency
+        }
+
+        withTestContainer {
+            let count = ManagedAtomic(0)
+            Container.cachedExampleDependency.register {
+                count.wrappingIncrement(ordering: .sequentiallyConsistent)
+                return ExampleDependency()
+            }
+            let example = Example()
+            let first = example.dependency
+            #expect(example.dependency === first)
+            #expect(count.load(ordering: .sequentiallyConsistent) == 1)
+
+            let replacement = ExampleDependency()
+            Container.cachedExampleDependency.register { replacement }
+            #expect(example.dependency === replacement)
+
+            // Popping keeps the cached value, and so does the memo.
+            Container.cachedExampleDependency.popRegistration()
+            #expect(example.dependency === replacement)
+
+            (example.$dependency.scope as? CachedScope)?.cache.clear()
+            #expect(example.dependency !== replacement)
+            #expect(count.load(ordering: .sequentiallyConsistent) == 2)
+
+            let outer = example.dependency
+            withNestedContainer {
+                // The memo misses in another container, but the cached scope falls back to the parent's value.
+                #expect(example.dependency === outer)
+            }
+            #expect(example.dependency === outer)
+        }
+    }
+
+    @Test func injectedPropertyWrapper_WhenMemoizedWithUniqueScope_StillResolvesEveryTime() async throws {
+        class Example {
+            @Injected(Container.exampleDependency, memoized: true) var dependency: ExampleDependency
+        }
+
+        withTestContainer {
+            Container.exampleDependency.register { ExampleDependency() }
+            let example = Example()
+            #expect(example.dependency !== example.dependency)
+        }
+    }
 }
 
 class ExampleDependency: @unchecked Sendable { }
@@ -137,6 +186,7 @@ class ExampleAsyncThrowingDependency: @unchecked Sendable {
 
 extension Container {
     static let exampleDependency = Factory { ExampleDependency() }
+    static let cachedExampleDependency = Factory(scope: .cached) { ExampleDependency() }
     static let exampleThrowingDependency = Factory { try ExampleThrowingDependency() }
     static let exampleAsyncDependency = Factory { await ExampleAsyncDependency() }
     static let exampleAsyncThrowingDependency = Factory { try await ExampleAsyncThrowingDependency() }
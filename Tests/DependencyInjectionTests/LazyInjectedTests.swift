@@ -110,4 +110,34 @@ struct LazyInjectedTests {
             #expect(await test.count == 2)
         }
     }
+    
+    @Test func lazyInjectedPropertyWrapper_WithDeferredAsyncFactory_StartsOnFirstAccessInItsInitContainer() async throws {
+        class Example {
+            @LazyInjected(Container.deferredAsyncDependency, startsOnFirstAccess: true) var dependency: Task<DeferredAsyncDependency?, Never>
+        }
+        
+        try await withNestedContainer {
+            let expected = DeferredAsyncDependency()
+            let count = ManagedAtomic(0)
+            let example = withNestedContainer {
+                Container.deferredAsyncDependency.register {
+                    count.wrappingIncrement(ordering: .sequentiallyConsistent)
+                    return expected
+                }
+                return Example()
+            }
+            try await Task.sleep(for: .milliseconds(10))
+            #expect(count.load(ordering: .sequentiallyConsistent) == 0)
+            // Resolved in the container the example was created in, not the current one
+            #expect(await example.dependency.value === expected)
+            #expect(await example.dependency.value === expected)
+            #expect(count.load(ordering: .sequentiallyConsistent) == 1)
+        }
+    }
+}
+
+final class DeferredAsyncDependency: Sendable { }
+
+extension Container {
+    static let deferredAsyncDependency = Factory { () async -> DeferredAsyncDependency? in nil }
 }
@@ -9,6 +9,7 @@ import Testing
 import Dispatch
 import Foundation
 @testable import DependencyInjection
+import DispatchInterpose
 
 struct TestContainerTests {
     nonisolated(unsafe) let failTestBehavior = UnregisteredBehavior.custom {
@@ -350,6 +351,41 @@ struct TestContainerTests {
         }
     }
     
+    #if DEBUG
+    @Test func leakedWorkDispatchedWhileATestContainerIsActiveRunsInItsTestContainer() async throws {
+        await withTestContainer(unregisteredBehavior: failTestBehavior) {
+            let (testContainer, leaked) = withTestContainer(unregisteredBehavior: failTestBehavior) {
+                let testContainer = Container.current
+                let leaked = Task {
+                    try? await Task.sleep(nanoseconds: 1_000_000)
+                    return await withCheckedContinuation { continuation in
+                        DispatchQueue.global().async { continuation.resume(returning: Container.current) }
+                    }
+                }
+                return (testContainer, leaked)
+            }
+
+            // The outer test container keeps the hooks bound after the inner one exits.
+            #expect(swift_async_hooks_installed())
+            #expect(await leaked.value === testContainer)
+        }
+    }
+
+    @Test func dispatchHooksOnlyUnprotectPagesHoldingPatchedSlots() async throws {
+        let (scanned, stats) = withTestContainer(unregisteredBehavior: failTestBehavior) {
+            var stats = rebind_image_stats()
+            return (rebind_get_image_stats(#dsohandle, &stats), stats)
+        }
+
+        // This test image calls DispatchQueue.async, so it has at least one slot to patch, and
+        // only the pages holding patched slots may have had their protection changed.
+        #expect(scanned)
+        #expect(stats.patched_slots > 0)
+        #expect(stats.protected_pages > 0)
+        #expect(stats.protected_pages <= stats.patched_slots)
+    }
+    #endif
+
     @Test func withNestedContainer_InsideTestContainer_DoesNotCrash() async throws {
         let factory = Factory { "test-value" }
         
@@ -612,6 +648,84 @@ struct TestContainerTests {
             #expect(Container.prodService() is NoopProdService) // does not crash
         }
     }
+    
+    @Test func testDefaultsCanBeBuiltInALoop() async throws {
+        let factories = (0..<3).map { i in Factory { i } }
+        let defaults = TestDefaults {
+            TestDefault {
+                for factory in factories {
+                    factory.testValue { -1 }
+                }
+            }
+        }
+        withTestContainer(defaults: defaults) {
+            #expect(factories.map { $0() } == [-1, -1, -1])
+        }
+    }
+
+    @Test func testDefaultsAreSharedWithoutLeakingRegistrations() async throws {
+        let factory = Factory { 0 }
+        let defaults = TestDefaults {
+            TestDefault { factory.testValue { -1 } }
+        }
+        withTestContainer(defaults: defaults) {
+            #expect(factory() == -1)
+            factory.register { 1 }
+            #expect(factory() == 1)
+            factory.popRegistration()
+            #expect(factory() == -1)
+            factory.register { 2 }
+        }
+        withTestContainer(defaults: defaults) {
+            #expect(factory() == -1)
+        }
+        #expect(defaults.registry === defaults.registry)
+    }
+
+    @Test func frozenContainerInlinesCachedValuesAndThawsWhenChanged() async throws {
+        class Super { }
+        let container = Container()
+        let cached = Factory(scope: .cached) { Super() }
+        let unique = Factory { 0 }
+        withContainer(container) { unique.register { 1 } }
+
+        container.freeze()
+        #expect(container.isFrozen)
+        withContainer(container) {
+            let first = cached()
+            #expect(cached() === first)
+            #expect(unique() == 1)
+
+            // Overrides and clears in other containers leave the inlined value in place.
+            withNestedContainer {
+                unique.register { 3 }
+                (cached.scope as? CachedScope)?.cache.clear()
+            }
+            #expect(container.registrySnapshot.frozen?[cached.slot]?.inlinedValue(as: Super.self) === first)
+
+            (cached.scope as? CachedScope)?.cache.clear()
+            #expect(cached() !== first)
+            #expect(container.isFrozen)
+
+            unique.register { 2 }
+            #expect(!container.isFrozen)
+            #expect(unique() == 2)
+        }
+
+        container.freeze()
+        container.fatalErrorOnResolve = true
+        #expect(!container.isFrozen)
+        container.freeze()
+        #expect(!container.isFrozen)
+    }
+
+    @Test func testContainerIsParentedDirectlyByTheCurrentContainer() async throws {
+        let outer = Container.current
+        withTestContainer {
+            #expect(Container.current is TestContainer)
+            #expect(Container.current.parent === outer)
+        }
+    }
 }
 
 // what a feature dev might write